@@ -0,0 +1,85 @@
+/*
+ * bench_binding.c - Call overhead of decl-based vs argc-based bindings
+ *
+ * Compares:
+ * - ph_def():      decl-based, signature parsed into a Python function wrapper
+ * - ph_def_fast(): argc-based, raw nativefunc with a call-time argc check
+ * - a plain Python function, as a reference point
+ *
+ * Also measures registration cost of N_DEFS functions:
+ * - ph_def_in() one by one vs ph_module_def_table() in one call
+ */
+
+#include "bench_common.h"
+
+#define N_CALLS 2000000
+#define N_DEFS 256
+#define N_ROUNDS 20
+
+static bool cfunc_add(int argc, py_StackRef argv) {
+    (void)argc;
+    PH_ARG_INT(0, a);
+    PH_ARG_INT(1, b);
+    PH_RETURN_INT(a + b);
+}
+
+static bool cfunc_noop(int argc, py_StackRef argv) {
+    (void)argc;
+    (void)argv;
+    PH_RETURN_NONE;
+}
+
+static char g_sigs[N_DEFS][32];
+
+static void bench_registration(void) {
+    ph_FuncDef defs[N_DEFS];
+    char module[32];
+
+    for (int i = 0; i < N_DEFS; i++) {
+        snprintf(g_sigs[i], sizeof(g_sigs[i]), "f%d(a, b)", i);
+        defs[i].sig = g_sigs[i];
+        defs[i].f = cfunc_add;
+    }
+
+    double t0 = bench_now();
+    for (int r = 0; r < N_ROUNDS; r++) {
+        snprintf(module, sizeof(module), "one_by_one_%d", r);
+        for (int i = 0; i < N_DEFS; i++) {
+            ph_def_in(module, g_sigs[i], cfunc_add);
+        }
+    }
+    double t1 = bench_now();
+    bench_report("register x256  ph_def_in", t1 - t0, (long)N_ROUNDS * N_DEFS);
+
+    t0 = bench_now();
+    for (int r = 0; r < N_ROUNDS; r++) {
+        snprintf(module, sizeof(module), "table_%d", r);
+        ph_module_def_table(module, defs, N_DEFS);
+    }
+    t1 = bench_now();
+    bench_report("register x256  ph_module_def_table", t1 - t0, (long)N_ROUNDS * N_DEFS);
+}
+
+BENCH_SUITE_BEGIN("Binding call overhead")
+    char src[256];
+
+    ph_def("add_decl(a, b)", cfunc_add);
+    ph_def_fast("add_fast", 2, cfunc_add);
+    ph_def("noop_decl()", cfunc_noop);
+    ph_def_fast("noop_fast", 0, cfunc_noop);
+    ph_exec("def add_py(a, b): return a + b", "<bench>");
+
+    snprintf(src, sizeof(src), "for _ in range(%d): add_decl(1, 2)", N_CALLS);
+    bench_exec("add(a, b)  ph_def", src, N_CALLS);
+    snprintf(src, sizeof(src), "for _ in range(%d): add_fast(1, 2)", N_CALLS);
+    bench_exec("add(a, b)  ph_def_fast", src, N_CALLS);
+    snprintf(src, sizeof(src), "for _ in range(%d): add_py(1, 2)", N_CALLS);
+    bench_exec("add(a, b)  python def", src, N_CALLS);
+
+    snprintf(src, sizeof(src), "for _ in range(%d): noop_decl()", N_CALLS);
+    bench_exec("noop()     ph_def", src, N_CALLS);
+    snprintf(src, sizeof(src), "for _ in range(%d): noop_fast()", N_CALLS);
+    bench_exec("noop()     ph_def_fast", src, N_CALLS);
+
+    bench_registration();
+BENCH_SUITE_END()
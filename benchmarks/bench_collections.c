@@ -0,0 +1,59 @@
+/*
+ * bench_collections.c - deque, heapq and bisect
+ *
+ * - deque append / popleft as a FIFO queue, and a bounded deque
+ * - heappush + heappop of 100k ints, heapify of 100k floats
+ * - bisect_left lookups and insort into a sorted list
+ */
+
+#include "bench_common.h"
+
+#define N 100000
+
+static const char* setup_src =
+    "from collections import deque\n"
+    "import heapq, bisect, random\n"
+    "random.seed(7)\n"
+    "ints = [random.randint(0, 1000000) for _ in range(100000)]\n"
+    "floats = [random.random() for _ in range(100000)]\n"
+    "table = sorted(ints)\n"
+    "probes = ints[:1000]\n";
+
+BENCH_SUITE_BEGIN("Collections")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+
+    printf("deque, per operation:\n");
+    bench_exec("append + popleft",
+               "q = deque()\n"
+               "for i in range(100000):\n"
+               "    q.append(i)\n"
+               "    q.append(i)\n"
+               "    q.popleft()\n",
+               3L * N);
+    bench_exec("append, maxlen=64",
+               "q = deque(maxlen=64)\n"
+               "for i in range(100000): q.append(i)\n",
+               N);
+
+    printf("heapq, per element:\n");
+    bench_exec("heappush + heappop (ints)",
+               "h = []\n"
+               "for x in ints: heapq.heappush(h, x)\n"
+               "while h: heapq.heappop(h)\n",
+               N);
+    bench_exec("heapify (floats)",
+               "for _ in range(10):\n"
+               "    h = floats.copy()\n"
+               "    heapq.heapify(h)\n",
+               10L * N);
+
+    printf("bisect, per call:\n");
+    bench_exec("bisect_left (100k ints)",
+               "for _ in range(100):\n"
+               "    for x in probes: bisect.bisect_left(table, x)\n",
+               N);
+    bench_exec("insort (10k ints)",
+               "a = []\n"
+               "for x in ints[:10000]: bisect.insort(a, x)\n",
+               10000);
+BENCH_SUITE_END()
@@ -0,0 +1,50 @@
+/*
+ * bench_common.h - Common benchmark utilities
+ *
+ * Benchmarks are plain executables (not part of ctest). Each one times a
+ * few Python snippets or C loops and prints the elapsed time per variant.
+ * Run them with `make bench`.
+ */
+
+#pragma once
+
+#include "pktpy_hi.h"
+#include <stdio.h>
+#include <time.h>
+
+// Monotonic wall-clock time in seconds
+static inline double bench_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Print one result line: label, total time and time per iteration
+static inline void bench_report(const char* label, double seconds, long iters) {
+    printf("  %-40s %8.3f ms  %8.1f ns/iter\n",
+           label, seconds * 1e3, seconds * 1e9 / (double)iters);
+}
+
+// Execute a snippet once and report its elapsed time.
+// The snippet is compiled as part of the measurement; keep loops long
+// enough that compilation is negligible.
+static inline void bench_exec(const char* label, const char* source, long iters) {
+    double t0 = bench_now();
+    bool ok = ph_exec(source, "<bench>");
+    double t1 = bench_now();
+    if (!ok) {
+        printf("  %-40s FAILED\n", label);
+        return;
+    }
+    bench_report(label, t1 - t0, iters);
+}
+
+#define BENCH_SUITE_BEGIN(name) \
+    int main(void) { \
+        printf("=== %s ===\n", name); \
+        py_initialize();
+
+#define BENCH_SUITE_END() \
+        py_finalize(); \
+        return 0; \
+    }
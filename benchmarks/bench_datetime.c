@@ -0,0 +1,48 @@
+/*
+ * bench_datetime.c - datetime and timedelta
+ *
+ * - construction and comparison of event times
+ * - sorting 100k datetimes
+ * - datetime + timedelta and datetime - datetime
+ * - parsing ISO 8601 timestamps
+ */
+
+#include "bench_common.h"
+
+#define N 100000
+
+static const char* setup_src =
+    "from datetime import datetime, timedelta\n"
+    "a = datetime(2024, 3, 10, 12, 30, 45)\n"
+    "b = datetime(2024, 3, 10, 12, 30, 46)\n"
+    "step = timedelta(seconds=1)\n"
+    "events = [datetime(2024, 1 + i % 12, 1 + i % 28, i % 24, i % 60, (i * 7) % 60)\n"
+    "          for i in range(100000)]\n"
+    "stamps = [e.isoformat() for e in events[:1000]]\n";
+
+BENCH_SUITE_BEGIN("datetime")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+
+    printf("per operation:\n");
+    bench_exec("datetime(y, m, d, H, M, S)",
+               "for i in range(100000): datetime(2024, 3, 10, 12, 30, 45)\n",
+               N);
+    bench_exec("a < b",
+               "for i in range(100000): a < b\n",
+               N);
+    bench_exec("a == b",
+               "for i in range(100000): a == b\n",
+               N);
+    bench_exec("sorted(100k datetimes), per element",
+               "sorted(events)\n",
+               N);
+    bench_exec("a + timedelta",
+               "for i in range(100000): a + step\n",
+               N);
+    bench_exec("b - a",
+               "for i in range(100000): b - a\n",
+               N);
+    bench_exec("datetime.fromisoformat",
+               "for i in range(100): [datetime.fromisoformat(s) for s in stamps]\n",
+               N);
+BENCH_SUITE_END()
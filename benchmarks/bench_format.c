@@ -0,0 +1,47 @@
+/*
+ * bench_format.c - Formatting numbers as text
+ *
+ * - repr() of floats with short (0.5, 1.25) and full 17-digit (1/3, 0.1 + 0.2)
+ *   shortest forms, and of large and tiny magnitudes in scientific notation
+ * - str() of small and 64-bit ints
+ * - json.dumps of a 10k-element list of floats and of ints (numeric export),
+ *   and from C with py_json_dumps
+ */
+
+#include "bench_common.h"
+
+#define N 200000
+
+static const char* setup_src =
+    "import json\n"
+    "floats = [i / 7 + 0.1 for i in range(10000)]\n"
+    "ints = [i * 1000003 - 5000000000 for i in range(10000)]\n"
+    "x, y, big, tiny = 0.1 + 0.2, 1.25, 6.02214076e23, 1.602176634e-19\n"
+    "n, big_n = 42, -9223372036854775807\n";
+
+BENCH_SUITE_BEGIN("format")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+
+    printf("per value:\n");
+    bench_exec("repr(1.25)", "for i in range(200000): repr(y)\n", N);
+    bench_exec("repr(0.1 + 0.2)", "for i in range(200000): repr(x)\n", N);
+    bench_exec("repr(6.02214076e23)", "for i in range(200000): repr(big)\n", N);
+    bench_exec("repr(1.602176634e-19)", "for i in range(200000): repr(tiny)\n", N);
+    bench_exec("str(42)", "for i in range(200000): str(n)\n", N);
+    bench_exec("str(-9223372036854775807)", "for i in range(200000): str(big_n)\n", N);
+
+    printf("10k-element list, per element:\n");
+    bench_exec("json.dumps(floats)", "for i in range(20): json.dumps(floats)\n", 20 * 10000);
+    bench_exec("json.dumps(ints)", "for i in range(20): json.dumps(ints)\n", 20 * 10000);
+    bench_exec("str(floats)", "for i in range(20): str(floats)\n", 20 * 10000);
+
+    py_Ref floats = ph_getglobal("floats");
+    double t0 = bench_now();
+    for (int i = 0; i < 20; i++) {
+        if (!py_json_dumps(floats, 0)) {
+            py_printexc();
+            return 1;
+        }
+    }
+    bench_report("py_json_dumps(floats) from C", bench_now() - t0, 20 * 10000);
+BENCH_SUITE_END()
@@ -0,0 +1,46 @@
+/*
+ * bench_frames.c - Call overhead of deep recursion vs. frame pool size
+ *
+ * A recursive function descends DEPTH levels, N_ROUNDS times, in VMs
+ * created with different frame pool sizes. Calls deeper than the pool
+ * fall back to malloc for their frames.
+ */
+
+#include "bench_common.h"
+
+#define DEPTH 400
+#define N_ROUNDS 2000
+
+static const char* setup_src =
+    "def depth(n):\n"
+    "    return 0 if n == 0 else depth(n - 1) + 1\n";
+
+static void bench_pool(const char* label, int frame_pool_size) {
+    ph_VMOptions opts = {.frame_pool_size = frame_pool_size};
+    int index = ph_vm_create(&opts);
+    if (index < 0) {
+        printf("  %-40s FAILED\n", label);
+        return;
+    }
+    py_switchvm(index);
+    ph_exec(setup_src, "<bench>");
+
+    char src[128];
+    snprintf(src, sizeof(src),
+             "for _ in range(%d):\n    depth(%d)\n", N_ROUNDS, DEPTH);
+    bench_exec(label, src, (long)N_ROUNDS * DEPTH);
+
+    ph_VMStats stats = ph_vm_stats();
+    printf("  %-40s %lld hits, %lld misses, peak depth %d\n", "",
+           (long long)stats.frame_pool_hits, (long long)stats.frame_pool_misses,
+           stats.peak_recursion_depth);
+
+    py_switchvm(0);
+    ph_vm_destroy(index);
+}
+
+BENCH_SUITE_BEGIN("Frames")
+    printf("recursion to depth %d, per call:\n", DEPTH);
+    bench_pool("frame pool 32 (default)", 0);
+    bench_pool("frame pool 512", 512);
+BENCH_SUITE_END()
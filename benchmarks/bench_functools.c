@@ -0,0 +1,54 @@
+/*
+ * bench_functools.c - partial, reduce and lru_cache
+ *
+ * - calling a partial with positional and keyword arguments
+ * - reduce over 100k ints
+ * - lru_cache hits on int and tuple keys, and a bounded cache that
+ *   keeps evicting
+ */
+
+#include "bench_common.h"
+
+#define N 100000
+
+static const char* setup_src =
+    "from functools import partial, reduce, lru_cache\n"
+    "def add3(a, b, c=0): return a + b + c\n"
+    "p = partial(add3, 1)\n"
+    "pk = partial(add3, 1, c=2)\n"
+    "ints = list(range(100000))\n"
+    "@lru_cache(maxsize=None)\n"
+    "def sq(x): return x * x\n"
+    "@lru_cache(maxsize=None)\n"
+    "def dist(x, y): return abs(x - y)\n"
+    "@lru_cache(maxsize=256)\n"
+    "def bounded(x): return x + 1\n"
+    "for i in range(1000): sq(i); dist(i, 7)\n";
+
+BENCH_SUITE_BEGIN("functools")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+
+    printf("partial, per call:\n");
+    bench_exec("p(x)",
+               "for i in range(100000): p(i)\n",
+               N);
+    bench_exec("p(x) with stored keyword",
+               "for i in range(100000): pk(i)\n",
+               N);
+
+    printf("reduce, per element:\n");
+    bench_exec("reduce(add3, 100k ints)",
+               "for _ in range(3): reduce(add3, ints)\n",
+               3L * N);
+
+    printf("lru_cache, per call:\n");
+    bench_exec("hit, int key",
+               "for i in range(100000): sq(i % 1000)\n",
+               N);
+    bench_exec("hit, tuple key",
+               "for i in range(100000): dist(i % 1000, 7)\n",
+               N);
+    bench_exec("miss + evict, maxsize=256",
+               "for i in range(100000): bounded(i)\n",
+               N);
+BENCH_SUITE_END()
@@ -0,0 +1,69 @@
+/*
+ * bench_import.c - Importing one file module into many VMs
+ *
+ * Each of the 15 secondary VMs imports the same generated library
+ * (N_FUNCS functions) through the importfile callback:
+ * - cache off: every VM compiles the file from source
+ * - cache on:  the file is compiled once, VMs share its bytecode
+ */
+
+#include "bench_common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define N_FUNCS 400
+#define N_ROUNDS 10
+
+static char* g_lib_src;
+
+static void build_lib_src(void) {
+    size_t cap = (size_t)N_FUNCS * 160;
+    g_lib_src = malloc(cap);
+    size_t len = 0;
+    for (int i = 0; i < N_FUNCS; i++) {
+        len += (size_t)snprintf(g_lib_src + len, cap - len,
+            "def f%d(a, b=%d, name='function number %d'):\n"
+            "    if a > b:\n"
+            "        return [a * %d, b, name]\n"
+            "    return {'a': a, 'b': b + %d}\n",
+            i, i, i, i, i);
+    }
+}
+
+static char* importfile_lib(const char* path) {
+    if (strcmp(path, "benchlib.py") != 0) return NULL;
+    size_t size = strlen(g_lib_src) + 1;
+    char* data = malloc(size);
+    memcpy(data, g_lib_src, size);
+    return data;
+}
+
+static void bench_import_vms(const char* label, bool cache) {
+    ph_set_import_cache(cache);
+    double total = 0;
+    for (int r = 0; r < N_ROUNDS; r++) {
+        for (int i = 1; i < 16; i++) {
+            py_switchvm(i);
+            py_resetvm();
+            py_callbacks()->importfile = importfile_lib;
+            double t0 = bench_now();
+            bool ok = ph_exec("import benchlib", "<bench>");
+            total += bench_now() - t0;
+            if (!ok) {
+                printf("  %-40s FAILED\n", label);
+                py_switchvm(0);
+                return;
+            }
+        }
+    }
+    py_switchvm(0);
+    bench_report(label, total, (long)N_ROUNDS * 15);
+}
+
+BENCH_SUITE_BEGIN("Import")
+    build_lib_src();
+    printf("import of a %d-function module, per VM:\n", N_FUNCS);
+    bench_import_vms("import x15 VMs  cache off", false);
+    bench_import_vms("import x15 VMs  cache on", true);
+    free(g_lib_src);
+BENCH_SUITE_END()
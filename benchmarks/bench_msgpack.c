@@ -0,0 +1,86 @@
+/*
+ * bench_msgpack.c - Host <-> script messages as msgpack and as JSON
+ *
+ * - encoding a typical message (ids, floats, short strings, a nested list)
+ *   with ph_msgpack_pack_to and with py_json_dumps
+ * - decoding it with ph_msgpack_unpack and with py_json_loads, which
+ *   compiles the text as a Python expression
+ * - a message carrying a 64 KB bytes payload (msgpack only: JSON has no
+ *   bytes); the payload skips the packer's buffer
+ */
+
+#include "bench_common.h"
+#include <string.h>
+
+#define N 20000
+
+static const char* setup_src =
+    "msg = {'id': 12345, 'op': 'update', 'ok': True, 'ratio': 0.75,\n"
+    "       'pos': [1.5, -2.25, 3.0], 'tags': ['red', 'green', 'blue'],\n"
+    "       'items': [{'k': i, 'name': 'item' + str(i)} for i in range(8)]}\n"
+    "blob_msg = {'id': 1, 'data': ('x' * 65536).encode()}\n";
+
+typedef struct {
+    unsigned char data[1 << 17];
+    int size;
+} wire_buffer;
+
+static wire_buffer g_wire;
+
+static bool wire_write(void* ctx, const void* data, int size) {
+    wire_buffer* buf = (wire_buffer*)ctx;
+    if (buf->size + size > (int)sizeof(buf->data)) return false;
+    memcpy(buf->data + buf->size, data, size);
+    buf->size += size;
+    return true;
+}
+
+static void bench_pack(const char* label, py_Ref val, long iters) {
+    ph_Writer writer = {wire_write, &g_wire};
+    double t0 = bench_now();
+    for (long i = 0; i < iters; i++) {
+        g_wire.size = 0;
+        if (!ph_msgpack_pack_to(val, writer)) return;
+    }
+    double t1 = bench_now();
+    bench_report(label, t1 - t0, iters);
+}
+
+static void bench_unpack(const char* label, long iters) {
+    double t0 = bench_now();
+    for (long i = 0; i < iters; i++) {
+        if (!ph_msgpack_unpack(g_wire.data, g_wire.size)) return;
+    }
+    double t1 = bench_now();
+    bench_report(label, t1 - t0, iters);
+}
+
+BENCH_SUITE_BEGIN("msgpack")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+    py_ItemRef msg = ph_getglobal("msg");
+
+    printf("per message:\n");
+    bench_pack("ph_msgpack_pack_to", msg, N);
+    printf("  (%d bytes)\n", g_wire.size);
+    bench_unpack("ph_msgpack_unpack", N);
+
+    double t0 = bench_now();
+    for (long i = 0; i < N; i++) {
+        if (!py_json_dumps(msg, 0)) return 1;
+    }
+    double t1 = bench_now();
+    bench_report("py_json_dumps", t1 - t0, N);
+    py_assign(py_r4(), py_retval());
+    printf("  (%d bytes)\n", (int)strlen(py_tostr(py_r4())));
+
+    t0 = bench_now();
+    for (long i = 0; i < N; i++) {
+        if (!py_json_loads(py_tostr(py_r4()))) return 1;
+    }
+    t1 = bench_now();
+    bench_report("py_json_loads", t1 - t0, N);
+
+    py_ItemRef blob_msg = ph_getglobal("blob_msg");
+    bench_pack("ph_msgpack_pack_to, 64 KB payload", blob_msg, N);
+    bench_unpack("ph_msgpack_unpack, 64 KB payload", N);
+BENCH_SUITE_END()
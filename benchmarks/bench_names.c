@@ -0,0 +1,75 @@
+/*
+ * bench_names.c - Name interning under thread contention
+ *
+ * T threads (1, 2, 4, 8) each intern names with py_namev, which is what the
+ * compiler, getattr by string and the ph_* string APIs do:
+ * - lookup: every name already exists (the common case)
+ * - insert: 1 in 16 names is new to the table
+ * Throughput should grow with T up to the number of cores.
+ */
+
+#include "bench_common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+
+#define N_NAMES 1024
+#define N_OPS 400000
+
+static char g_names[N_NAMES][32];
+
+typedef struct {
+    int thread_index;
+    bool insert;
+} Job;
+
+static void* intern_worker(void* arg) {
+    Job* job = arg;
+    char buf[48];
+    for (int i = 0; i < N_OPS; i++) {
+        const char* name = g_names[(i * 7 + job->thread_index) % N_NAMES];
+        if (job->insert && i % 16 == 0) {
+            int n = snprintf(buf, sizeof(buf), "t%d_new_%d", job->thread_index, i);
+            py_namev((c11_sv){buf, n});
+        } else {
+            py_name(name);
+        }
+    }
+    return NULL;
+}
+
+static void bench_threads(const char* label, int n_threads, bool insert) {
+    pthread_t threads[8];
+    Job jobs[8];
+    double t0 = bench_now();
+    for (int t = 0; t < n_threads; t++) {
+        jobs[t] = (Job){t, insert};
+        pthread_create(&threads[t], NULL, intern_worker, &jobs[t]);
+    }
+    for (int t = 0; t < n_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    char line[64];
+    snprintf(line, sizeof(line), "%s  %d thread%s", label, n_threads, n_threads > 1 ? "s" : "");
+    bench_report(line, bench_now() - t0, (long)N_OPS * n_threads);
+}
+
+BENCH_SUITE_BEGIN("Names")
+    for (int i = 0; i < N_NAMES; i++) {
+        snprintf(g_names[i], sizeof(g_names[i]), "attribute_name_%d", i);
+        py_name(g_names[i]);
+    }
+    printf("py_namev throughput, per name:\n");
+    for (int t = 1; t <= 8; t *= 2) bench_threads("lookup", t, false);
+    for (int t = 1; t <= 8; t *= 2) bench_threads("insert 1/16", t, true);
+BENCH_SUITE_END()
+
+#else
+
+BENCH_SUITE_BEGIN("Names")
+    printf("  (requires pthreads)\n");
+BENCH_SUITE_END()
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * bench_re.c - Tokenizing and rewriting text with the re module
+ *
+ * - splitting a 60-character line into identifiers, numbers and operators
+ *   with a hand-written character loop vs re.findall
+ * - a precompiled Pattern.search vs module-level re.search (pattern cache)
+ * - re.sub with a template and with a replacement function
+ * - scanning a ~64 KB text for a literal-prefixed pattern
+ */
+
+#include "bench_common.h"
+
+#define N 20000
+
+static const char* setup_src =
+    "import re\n"
+    "line = 'total_cost = price * 1024 + tax_rate * (base - 7) / 3.5;'\n"
+    "tok = re.compile(r'\\d+(?:\\.\\d+)?|\\w+|[^\\w\\s]')\n"
+    "date = re.compile(r'(\\d{4})-(\\d{2})-(\\d{2})')\n"
+    "stamp = 'logged at 2024-03-17 by admin'\n"
+    "text = ('lorem ipsum dolor sit amet ' * 2400) + 'ERROR: disk full'\n"
+    "DIGITS = '0123456789'\n"
+    "WORD = 'abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ_' + DIGITS\n"
+    "def by_hand(s):\n"
+    "    out = []\n"
+    "    i = 0\n"
+    "    n = len(s)\n"
+    "    while i < n:\n"
+    "        c = s[i]\n"
+    "        if c == ' ':\n"
+    "            i += 1\n"
+    "        elif c in DIGITS:\n"
+    "            j = i + 1\n"
+    "            while j < n and (s[j] in DIGITS or s[j] == '.'): j += 1\n"
+    "            out.append(s[i:j])\n"
+    "            i = j\n"
+    "        elif c in WORD:\n"
+    "            j = i + 1\n"
+    "            while j < n and s[j] in WORD: j += 1\n"
+    "            out.append(s[i:j])\n"
+    "            i = j\n"
+    "        else:\n"
+    "            out.append(c)\n"
+    "            i += 1\n"
+    "    return out\n"
+    "assert by_hand(line) == tok.findall(line)\n";
+
+BENCH_SUITE_BEGIN("re")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+
+    printf("tokenizing a 60-char line:\n");
+    bench_exec("hand-written loop",
+               "for i in range(20000): by_hand(line)\n", N);
+    bench_exec("Pattern.findall",
+               "for i in range(20000): tok.findall(line)\n", N);
+
+    printf("searching a short string:\n");
+    bench_exec("Pattern.search (precompiled)",
+               "for i in range(20000): date.search(stamp)\n", N);
+    bench_exec("re.search (cached pattern)",
+               "for i in range(20000): re.search(r'(\\d{4})-(\\d{2})-(\\d{2})', stamp)\n", N);
+
+    printf("substitution:\n");
+    bench_exec("Pattern.sub with template",
+               "for i in range(20000): date.sub(r'\\3/\\2/\\1', stamp)\n", N);
+    bench_exec("Pattern.sub with function",
+               "for i in range(20000): date.sub(lambda m: m.group(1), stamp)\n", N);
+
+    printf("~64 KB text:\n");
+    bench_exec("re.search('ERROR: .*'), per call",
+               "for i in range(200): re.search('ERROR: .*', text)\n", 200);
+BENCH_SUITE_END()
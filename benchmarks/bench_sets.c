@@ -0,0 +1,57 @@
+/*
+ * bench_sets.c - Set construction, membership and set algebra
+ *
+ * - building a set from a range, a comprehension and a {...} display
+ * - `in` on a 100k-element set of ints and of strs (hits and misses)
+ * - union / intersection / difference of two 100k-element sets
+ * - ph_set_from_ints from a C array (presized, no bytecode)
+ */
+
+#include "bench_common.h"
+
+#define N 100000
+#define LOOKUPS 1000000
+
+static const char* setup_src =
+    "ints = set(range(100000))\n"
+    "strs = set([str(i) for i in range(100000)])\n"
+    "probe_ints = [i * 7 % 200000 for i in range(1000)]\n"
+    "probe_strs = [str(i) for i in probe_ints]\n"
+    "other = set(range(50000, 150000))\n";
+
+static py_i64 values[N];
+
+BENCH_SUITE_BEGIN("Sets")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+
+    printf("construction, per element:\n");
+    bench_exec("set(range(100k))", "for _ in range(10): s = set(range(100000))", 10L * N);
+    bench_exec("{i for i in range(100k)}",
+               "for _ in range(10): s = {i for i in range(100000)}", 10L * N);
+    bench_exec("{a, b, c, d} display", "for i in range(100000): s = {i, 1, 2, 3}", 4L * N);
+
+    for (int i = 0; i < N; i++) values[i] = (py_i64)i * 7;
+    double t0 = bench_now();
+    for (int r = 0; r < 10; r++) ph_set_from_ints(py_r0(), values, N);
+    double t1 = bench_now();
+    bench_report("ph_set_from_ints", t1 - t0, 10L * N);
+
+    printf("membership, per lookup (half hits):\n");
+    bench_exec("int in set",
+               "n = 0\n"
+               "for _ in range(1000):\n"
+               "    for x in probe_ints:\n"
+               "        if x in ints: n += 1\n",
+               LOOKUPS);
+    bench_exec("str in set",
+               "n = 0\n"
+               "for _ in range(1000):\n"
+               "    for x in probe_strs:\n"
+               "        if x in strs: n += 1\n",
+               LOOKUPS);
+
+    printf("set algebra, per element:\n");
+    bench_exec("a | b", "for _ in range(10): r = ints | other", 10L * 2 * N);
+    bench_exec("a & b", "for _ in range(10): r = ints & other", 10L * N);
+    bench_exec("a - b", "for _ in range(10): r = ints - other", 10L * N);
+BENCH_SUITE_END()
@@ -0,0 +1,66 @@
+/*
+ * bench_sort.c - Sorting 1M-element lists
+ *
+ * - list.sort() on ints, floats and strs (no key): compared natively,
+ *   without dispatching through __lt__
+ * - list.sort() on already- and nearly-sorted ints: natural runs make
+ *   these close to a single linear pass
+ * - list.sort(key=...) on (id, score) records: the key runs once per
+ *   element (decorate-sort-undecorate), not twice per comparison
+ * - ph_list_sort_by with a native key on the same records
+ */
+
+#include "bench_common.h"
+
+#define N 1000000
+
+static const char* setup_src =
+    "import random\n"
+    "random.seed(42)\n"
+    "ints = [random.randint(0, 1 << 30) for _ in range(1000000)]\n"
+    "floats = [random.random() for _ in range(1000000)]\n"
+    "strs = [str(v) for v in ints]\n"
+    "nearly = list(range(1000000))\n"
+    "for _ in range(1000):\n"
+    "    nearly[random.randint(0, 999999)] = random.randint(0, 999999)\n"
+    "records = [(i, random.randint(0, 1000)) for i in range(1000000)]\n";
+
+static bool score_key(py_Ref item, py_OutRef out, void* ctx) {
+    (void)ctx;
+    py_assign(out, py_tuple_getitem(item, 1));
+    return true;
+}
+
+BENCH_SUITE_BEGIN("Sort")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+    printf("%d elements, per element:\n", N);
+
+    ph_exec("data = ints[:]", "<bench>");
+    bench_exec("list.sort() ints", "data.sort()", N);
+
+    ph_exec("data = floats[:]", "<bench>");
+    bench_exec("list.sort() floats", "data.sort()", N);
+
+    ph_exec("data = strs[:]", "<bench>");
+    bench_exec("list.sort() strs", "data.sort()", N);
+
+    ph_exec("data = list(range(1000000))", "<bench>");
+    bench_exec("list.sort() already sorted", "data.sort()", N);
+
+    ph_exec("data = nearly[:]", "<bench>");
+    bench_exec("list.sort() nearly sorted", "data.sort()", N);
+
+    ph_exec("data = records[:]", "<bench>");
+    bench_exec("list.sort(key=lambda) records", "data.sort(key=lambda r: r[1])", N);
+
+    ph_exec("data = records[:]", "<bench>");
+    bench_exec("sorted(key=lambda, reverse=True)",
+               "out = sorted(data, key=lambda r: r[1], reverse=True)", N);
+
+    ph_exec("data = records[:]", "<bench>");
+    py_ItemRef data = ph_getglobal("data");
+    double t0 = bench_now();
+    bool ok = ph_list_sort_by(data, score_key, NULL, false);
+    double t1 = bench_now();
+    if (ok) bench_report("ph_list_sort_by native key", t1 - t0, N);
+BENCH_SUITE_END()
@@ -0,0 +1,123 @@
+/*
+ * bench_str.c - Common operations on long strings
+ *
+ * - dict lookups and updates with 40-character str keys
+ * - dict inserts and lookups with freshly built keys (uncached hashes) for
+ *   three key shapes: ~55-char URLs, ~45-char JSON paths, short identifiers,
+ *   and interning the same keys as names, which is mostly hashing
+ * - len() of a 4 KB string inside a loop
+ * - indexing and slicing a 4 KB ASCII string, and indexing a non-ASCII one
+ * - find / count / split / replace / `in` over a ~64 KB log
+ * - building output: joining 1k and 10k fragments from a list or an iterator,
+ *   and f-strings with several fields
+ */
+
+#include "bench_common.h"
+#include <string.h>
+
+#define N 200000
+#define NKEYS 50000
+
+static char keys[NKEYS][64];
+
+// insert every key as a new str, then look each one up with another new str
+static void bench_dict_keys(const char* label) {
+    char name[64];
+    py_newdict(py_r0());
+    double t0 = bench_now();
+    for (int i = 0; i < NKEYS; i++) {
+        py_newstr(py_r1(), keys[i]);
+        py_newint(py_r2(), i);
+        py_dict_setitem(py_r0(), py_r1(), py_r2());
+    }
+    double t1 = bench_now();
+    int found = 0;
+    for (int i = 0; i < NKEYS; i++) {
+        py_newstr(py_r1(), keys[i]);
+        found += py_dict_getitem(py_r0(), py_r1()) == 1;
+    }
+    double t2 = bench_now();
+    if (found != NKEYS) printf("  %s: lookups failed\n", label);
+    // interned name lookups hash the key and walk a chain without allocating
+    for (int i = 0; i < NKEYS; i++) py_name(keys[i]);
+    double t3 = bench_now();
+    for (int r = 0; r < 10; r++) {
+        for (int i = 0; i < NKEYS; i++) py_namev((c11_sv){keys[i], (int)strlen(keys[i])});
+    }
+    double t4 = bench_now();
+    snprintf(name, sizeof(name), "%s insert", label);
+    bench_report(name, t1 - t0, NKEYS);
+    snprintf(name, sizeof(name), "%s lookup", label);
+    bench_report(name, t2 - t1, NKEYS);
+    snprintf(name, sizeof(name), "%s py_namev (hash + probe)", label);
+    bench_report(name, t4 - t3, 10L * NKEYS);
+}
+
+static const char* setup_src =
+    "keys = [f'user:{i:08d}:session:token:value:' for i in range(256)]\n"
+    "counts = {k: 0 for k in keys}\n"
+    "text = 'lorem ipsum dolor sit amet, ' * 147\n"
+    "utext = 'ünïcödé ' * 512\n"
+    "log = ''.join([f'2024-03-17 12:{i % 60:02d}:{i % 59:02d} INFO worker-{i % 8} "
+    "handled request id={i} status=200\\n' for i in range(1000)])\n"
+    "log += '2024-03-17 13:00:00 ERROR worker-3 connection reset by peer\\n'\n"
+    "rows = [f'<tr><td>{i}</td><td>item {i}</td></tr>' for i in range(10000)]\n"
+    "rows_1k = rows[:1000]\n"
+    "name, qty, price = 'widget', 12, 3.25\n";
+
+BENCH_SUITE_BEGIN("str")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+
+    printf("dict with 40-char str keys:\n");
+    bench_exec("counts[k] lookup",
+               "for i in range(200000): counts[keys[i & 255]]\n", N);
+    bench_exec("counts[k] += 1",
+               "for i in range(200000):\n"
+               "    k = keys[i & 255]\n"
+               "    counts[k] += 1\n", N);
+
+    printf("4 KB string:\n");
+    bench_exec("len(text)",
+               "for i in range(200000): len(text)\n", N);
+    bench_exec("text[i] (ASCII)",
+               "for i in range(200000): text[i & 4095]\n", N);
+    bench_exec("text[i:i + 8] (ASCII)",
+               "for i in range(200000): text[i & 4095:(i & 4095) + 8]\n", N);
+    bench_exec("utext[i] (non-ASCII)",
+               "for i in range(200000): utext[i & 4095]\n", N);
+
+    printf("~64 KB log, per call:\n");
+    bench_exec("log.find('connection reset')",
+               "for i in range(2000): log.find('connection reset')\n", 2000);
+    bench_exec("log.count('status=200')",
+               "for i in range(2000): log.count('status=200')\n", 2000);
+    bench_exec("'ERROR' in log",
+               "for i in range(2000): 'ERROR' in log\n", 2000);
+    bench_exec("log.split('\\n')",
+               "for i in range(200): log.split('\\n')\n", 200);
+    bench_exec("log.replace('INFO', 'info')",
+               "for i in range(200): log.replace('INFO', 'info')\n", 200);
+
+    printf("building output:\n");
+    bench_exec("''.join(list of 1k rows), per call",
+               "for i in range(2000): ''.join(rows_1k)\n", 2000);
+    // the 330 KB result is a fresh mmap on most allocators, so page faults dominate
+    bench_exec("''.join(list of 10k rows), per call",
+               "for i in range(200): ''.join(rows)\n", 200);
+    bench_exec("'\\n'.join(map(str.upper, rows)), per call",
+               "for i in range(20): '\\n'.join(map(str.upper, rows))\n", 20);
+    bench_exec("f-string with 3 fields",
+               "for i in range(200000): f'{name}: {qty} x {price} = {i}'\n", N);
+
+    printf("dict with %d fresh str keys, per operation:\n", NKEYS);
+    for (int i = 0; i < NKEYS; i++) {
+        snprintf(keys[i], 64, "https://api.example.com/v2/customers/%d/orders/%d", i / 7, i);
+    }
+    bench_dict_keys("URL keys");
+    for (int i = 0; i < NKEYS; i++) {
+        snprintf(keys[i], 64, "$.store.inventory[%d].variants[%d].price", i / 5, i % 5);
+    }
+    bench_dict_keys("JSON path keys");
+    for (int i = 0; i < NKEYS; i++) snprintf(keys[i], 64, "field_%d", i);
+    bench_dict_keys("short keys");
+BENCH_SUITE_END()
@@ -0,0 +1,51 @@
+/*
+ * bench_struct.c - Decoding fixed-layout binary records in a script
+ *
+ * - a 16-byte record (u16, u16, i32, f64) decoded with a precompiled
+ *   Struct, with module-level struct.unpack (format parsed per call),
+ *   and by slicing bytes and rebuilding the ints by hand
+ * - encoding the same record with Struct.pack
+ * - walking a 64 KB buffer of records with iter_unpack
+ */
+
+#include "bench_common.h"
+#include <string.h>
+
+#define N 100000
+
+static const char* setup_src =
+    "import struct\n"
+    "rec = struct.Struct('<HHid')\n"
+    "data = rec.pack(7, 513, -123456, 2.5)\n"
+    "def by_hand(b):\n"
+    "    a = b[0] | (b[1] << 8)\n"
+    "    c = b[2] | (b[3] << 8)\n"
+    "    v = b[4] | (b[5] << 8) | (b[6] << 16) | (b[7] << 24)\n"
+    "    if v >= 0x80000000: v -= 0x100000000\n"
+    "    return a, c, v\n";
+
+BENCH_SUITE_BEGIN("struct")
+    if (!ph_exec(setup_src, "<bench>")) return 1;
+
+    // 4096 copies of the record, built host-side
+    int size;
+    const unsigned char* rec = py_tobytes(ph_getglobal("data"), &size);
+    unsigned char* blob = py_newbytes(py_r0(), size * 4096);
+    for (int i = 0; i < 4096; i++) memcpy(blob + i * size, rec, size);
+    py_setglobal(py_name("blob"), py_r0());
+
+    printf("per 16-byte record:\n");
+    bench_exec("Struct.unpack (precompiled)",
+               "for i in range(100000): rec.unpack(data)\n", N);
+    bench_exec("struct.unpack('<HHid', ...)",
+               "for i in range(100000): struct.unpack('<HHid', data)\n", N);
+    bench_exec("manual slicing (ints only)",
+               "for i in range(100000): by_hand(data)\n", N);
+    bench_exec("Struct.pack",
+               "for i in range(100000): rec.pack(7, 513, -123456, 2.5)\n", N);
+
+    printf("64 KB buffer (4096 records):\n");
+    bench_exec("list(rec.iter_unpack(blob)), per record",
+               "for i in range(25): list(rec.iter_unpack(blob))\n",
+               25 * 4096);
+BENCH_SUITE_END()
@@ -0,0 +1,40 @@
+/*
+ * bench_vm.c - Cost of creating and tearing down VMs
+ *
+ * Builtin python sources, stdlib modules and bound signatures are compiled
+ * once per process, so only the first VM pays for compilation. With
+ * PH_FROZEN_STDLIB the python sources are shipped as bytecode generated at
+ * build time, so the first VM and the first import skip the compiler too.
+ */
+
+#include "bench_common.h"
+
+#define N_ROUNDS 1000
+
+BENCH_SUITE_BEGIN("VM")
+    double t0 = bench_now();
+    ph_exec("import collections, dataclasses, datetime, typing", "<bench>");
+    bench_report("first stdlib import", bench_now() - t0, 1);
+
+    t0 = bench_now();
+    for (int r = 0; r < N_ROUNDS; r++) {
+        int index = ph_vm_create(NULL);
+        ph_vm_destroy(index);
+    }
+    bench_report("ph_vm_create + ph_vm_destroy", bench_now() - t0, N_ROUNDS);
+
+    py_switchvm(1);
+    t0 = bench_now();
+    for (int r = 0; r < N_ROUNDS; r++) {
+        py_resetvm();
+    }
+    bench_report("py_resetvm", bench_now() - t0, N_ROUNDS);
+
+    t0 = bench_now();
+    for (int r = 0; r < N_ROUNDS; r++) {
+        py_resetvm();
+        ph_exec("import collections, dataclasses", "<bench>");
+    }
+    bench_report("py_resetvm + stdlib import", bench_now() - t0, N_ROUNDS);
+    py_switchvm(0);
+BENCH_SUITE_END()
@@ -283,6 +283,20 @@ static inline py_GlobalRef ph_bool_r(int reg, bool val) {
     return py_getreg(reg);
 }
 
+// datetime.datetime from nanoseconds since 1970-01-01 00:00:00 (naive)
+static inline py_GlobalRef ph_datetime_r(int reg, py_i64 ns) {
+    if (!ph__check_reg(reg)) return NULL;
+    py_newdatetime(py_getreg(reg), ns);
+    return py_getreg(reg);
+}
+
+// datetime.timedelta from nanoseconds
+static inline py_GlobalRef ph_timedelta_r(int reg, py_i64 ns) {
+    if (!ph__check_reg(reg)) return NULL;
+    py_newtimedelta(py_getreg(reg), ns);
+    return py_getreg(reg);
+}
+
 /* ============================================================================
  * 4. Safe Function Calls
  * ============================================================================
@@ -1164,6 +1178,18 @@ static inline bool ph_as_bool(py_Ref val, bool default_val) {
     return default_val;
 }
 
+// Get nanoseconds since 1970-01-01 of a datetime.datetime (or date) or default
+static inline py_i64 ph_as_datetime_ns(py_Ref val, py_i64 default_val) {
+    if (py_isinstance(val, tp_date)) return py_todatetime(val);
+    return default_val;
+}
+
+// Get nanoseconds of a datetime.timedelta or default
+static inline py_i64 ph_as_timedelta_ns(py_Ref val, py_i64 default_val) {
+    if (py_istype(val, tp_timedelta)) return py_totimedelta(val);
+    return default_val;
+}
+
 // Check if value is truthy (handles exceptions internally)
 // Note: py_bool returns 1 for true, 0 for false, -1 for error
 // For some types (strings, lists) it may return length as truthy indicator
@@ -1213,6 +1239,52 @@ static inline void ph_def_in(const char* module_path, const char* sig, py_CFunct
     py_bind(mod, sig, f);
 }
 
+/*
+ * Fast binding ("argc-based" style).
+ * Registers a raw nativefunc via py_bindfuncn() instead of parsing a
+ * signature into a Python-level function wrapper. Calls skip argument
+ * binding and defaults; only the argument count is checked at call time,
+ * including when the function is bound as a magic method and called by
+ * an operator (`obj[i]`, `x in obj`, `a + b`, ...).
+ * Use argc = -1 to skip the check (the function must validate argc itself).
+ * Keyword arguments are not supported.
+ */
+static inline void ph_def_fast(const char* name, int argc, py_CFunction f) {
+    py_GlobalRef main_mod = py_getmodule("__main__");
+    py_bindfuncn(main_mod, name, f, argc);
+}
+
+// Fast-bind a C function to a named module (creates module if needed)
+static inline void ph_def_fast_in(const char* module_path, const char* name, int argc, py_CFunction f) {
+    py_GlobalRef mod = py_getmodule(module_path);
+    if (!mod) {
+        mod = py_newmodule(module_path);
+    }
+    py_bindfuncn(mod, name, f, argc);
+}
+
+/*
+ * Compile-time macros (current VM only).
+ * Must be registered BEFORE the scripts that use them are compiled.
+ *
+ * ph_macro_const: bare references to `name` are folded into code-object
+ *   constants, so `if FEATURE_X:` compiles to a constant load instead of a
+ *   global lookup. The name becomes read-only in scripts (assigning to it,
+ *   or using it as a parameter, loop variable, def/class name or import
+ *   alias, is a SyntaxError). Prefer immutable values (int, float, str,
+ *   bool, None).
+ *
+ * ph_macro_def: calls like `NAME(1, 'a')` with literal arguments are
+ *   evaluated once by the compiler and their result stored as a constant.
+ */
+static inline void ph_macro_const(const char* name, py_Ref value) {
+    py_macroconst(name, value);
+}
+
+static inline void ph_macro_def(const char* sig, py_CFunction f) {
+    py_macrobind(sig, f);
+}
+
 // Set a global variable in __main__
 static inline void ph_setglobal(const char* name, py_Ref val) {
     py_setglobal(py_name(name), val);
@@ -1232,6 +1304,63 @@ static inline py_GlobalRef ph_module(const char* path) {
     return mod;
 }
 
+/*
+ * Bulk binding table (decl-based signatures).
+ * Resolves the module once, presizes its dict, and compiles all signatures
+ * in a single pass. Aborts on an invalid signature, like ph_def().
+ *
+ *   static const ph_FuncDef kMathDefs[] = {
+ *       {"add(a, b)", my_add},
+ *       {"clamp(x, lo=0, hi=1)", my_clamp},
+ *   };
+ *   ph_module_def_table("mymath", kMathDefs, PH_COUNTOF(kMathDefs));
+ */
+typedef py_FuncDef ph_FuncDef;
+
+#define PH_COUNTOF(arr) ((int)(sizeof(arr) / sizeof((arr)[0])))
+
+// Bind a table of C functions to a named module (creates module if needed)
+static inline void ph_module_def_table(const char* module_path, const ph_FuncDef* table, int n) {
+    py_bindtable(ph_module(module_path), table, n);
+}
+
+/*
+ * Lazy native modules.
+ * The registry is process-wide: init_fn runs the first time `path` is
+ * imported in each VM, so VMs only build the modules their scripts use.
+ * Register at startup, before VMs run on other threads.
+ *
+ *   static void init_mymath(py_GlobalRef mod) {
+ *       py_bind(mod, "add(a, b)", my_add);
+ *   }
+ *   ph_register_lazy_module("mymath", init_mymath);
+ */
+typedef void (*ph_ModuleInit)(py_GlobalRef mod);
+
+static inline void ph_register_lazy_module(const char* path, ph_ModuleInit init_fn) {
+    py_registerlazymodule(path, init_fn);
+}
+
+/*
+ * Import cache.
+ * Modules loaded from files are compiled once per process and their bytecode
+ * is shared by every VM that imports them; each VM only rebuilds constants.
+ * Enabled by default. Toggle at startup, before VMs run on other threads.
+ */
+static inline void ph_set_import_cache(bool enabled) {
+    py_setimportcache(enabled);
+}
+
+/*
+ * Hash seed.
+ * Seeds the str hash used by dicts, sets and name interning for the whole
+ * process. Call before py_initialize. The default seed 0 gives the
+ * same hashes on every run; a random seed resists hash-flooding input.
+ */
+static inline void ph_set_hash_seed(uint64_t seed) {
+    py_sethashseed(seed);
+}
+
 /* ============================================================================
  * 7. Argument Helpers for Native Functions
  * ============================================================================
@@ -1378,6 +1507,24 @@ static inline bool ph_list_foreach(py_Ref list, ph_ListCallback cb, void* ctx) {
     return true;
 }
 
+typedef py_KeyFunc ph_KeyFunc;
+
+// Stable in-place sort by a native key. key(item, out, ctx) writes the sort
+// key of each element into out; it runs once per element, not per comparison.
+// Prints and clears any exception.
+static inline bool ph_list_sort_by(py_Ref list, ph_KeyFunc key, void* ctx, bool reverse) {
+    ph_Scope scope = ph_scope_begin();
+    py_list_sortby(list, key, ctx, reverse);
+    return ph_scope_end_print(&scope);
+}
+
+// Same as ph_list_sort_by, propagating any exception
+static inline bool ph_list_sort_by_raise(py_Ref list, ph_KeyFunc key, void* ctx, bool reverse) {
+    ph_Scope scope = ph_scope_begin();
+    py_list_sortby(list, key, ctx, reverse);
+    return ph_scope_end_raise(&scope);
+}
+
 // Build a list from C array of ints
 static inline void ph_list_from_ints(py_OutRef out, const py_i64* vals, int count) {
     py_newlistn(out, count);
@@ -1410,6 +1557,40 @@ static inline void ph_list_from_bools(py_OutRef out, const bool* vals, int count
     }
 }
 
+// Build a set from C array of ints. The table is sized once for count
+// elements; duplicates collapse.
+static inline void ph_set_from_ints(py_OutRef out, const py_i64* vals, int count) {
+    py_newset(out);
+    py_set_reserve(out, count);
+    py_TValue tmp;
+    for (int i = 0; i < count; i++) {
+        py_newint(&tmp, vals[i]);
+        py_set_add(out, &tmp);
+    }
+}
+
+// Build a set from C array of floats
+static inline void ph_set_from_floats(py_OutRef out, const py_f64* vals, int count) {
+    py_newset(out);
+    py_set_reserve(out, count);
+    py_TValue tmp;
+    for (int i = 0; i < count; i++) {
+        py_newfloat(&tmp, vals[i]);
+        py_set_add(out, &tmp);
+    }
+}
+
+// Build a set from C array of strings
+static inline void ph_set_from_strs(py_OutRef out, const char** vals, int count) {
+    py_newset(out);
+    py_set_reserve(out, count);
+    py_TValue tmp;
+    for (int i = 0; i < count; i++) {
+        py_newstr(&tmp, vals[i]);
+        py_set_add(out, &tmp);
+    }
+}
+
 /* ============================================================================
  * 9. Debug/Development Helpers
  * ============================================================================
@@ -1442,6 +1623,109 @@ static inline const char* ph_typename(py_Ref val) {
     return py_tpname(py_typeof(val));
 }
 
+/* ============================================================================
+ * 10. VM Management
+ * ============================================================================
+ * Per-VM resource controls. All functions apply to the current VM
+ * (see py_switchvm).
+ */
+
+typedef py_VMOptions ph_VMOptions;
+typedef py_MemoryStats ph_MemoryStats;
+typedef py_VMStats ph_VMStats;
+
+// Create a VM in the first free slot and return its index (-1 if all 16 are
+// taken or opts->stack_size is below PK_VM_MIN_STACK_SIZE). The value stack
+// is allocated at opts->stack_size slots, so small scripts can run in a few
+// KB and deeply recursive ones can get more.
+// Pass NULL for the defaults. Does not switch to the new VM.
+static inline int ph_vm_create(const ph_VMOptions* opts) {
+    return py_newvm(opts);
+}
+
+// Delete a VM created by ph_vm_create (not the default or current VM)
+static inline void ph_vm_destroy(int index) {
+    py_delvm(index);
+}
+
+// Cap the memory of the current VM (0 = unlimited). Growth past the limit
+// raises MemoryError in the running script once a full collection cannot
+// bring usage back under it.
+static inline void ph_vm_set_memory_limit(size_t bytes) {
+    py_setmemorylimit(bytes);
+}
+
+// Memory usage of the current VM: heap, strings, buffers and stack
+static inline ph_MemoryStats ph_vm_memory_stats(void) {
+    ph_MemoryStats stats;
+    py_memorystats(&stats);
+    return stats;
+}
+
+// Call statistics of the current VM: frame pool hits and misses (fallback
+// mallocs) and peak call depth. A peak depth above frame_pool_size means
+// calls past that depth malloc their frames; size the pool with
+// ph_VMOptions.frame_pool_size.
+static inline ph_VMStats ph_vm_stats(void) {
+    ph_VMStats stats;
+    py_vmstats(&stats);
+    return stats;
+}
+
+/* ============================================================================
+ * 11. Binary Serialization (msgpack)
+ * ============================================================================
+ * Compact binary messages between the host and script VMs. Requires the
+ * msgpack module (PK_BUILD_MODULE_MSGPACK, CMake option PH_MSGPACK).
+ *
+ * Packs None, bool, int, float, str, bytes, list, tuple, dict and datetime;
+ * arrays unpack as lists.
+ */
+
+#ifdef PK_BUILD_MODULE_MSGPACK
+
+typedef py_WriteFunc ph_WriteFunc;
+
+// Output sink: write(ctx, data, size) returns false to abort
+typedef struct {
+    ph_WriteFunc write;
+    void* ctx;
+} ph_Writer;
+
+// Pack val into writer. Output arrives in chunks of a few KB; large str and
+// bytes payloads are passed straight from the object, without a copy.
+// Prints and clears any exception.
+static inline bool ph_msgpack_pack_to(py_Ref val, ph_Writer writer) {
+    ph_Scope scope = ph_scope_begin();
+    py_msgpack_pack(val, writer.write, writer.ctx);
+    return ph_scope_end_print(&scope);
+}
+
+// Same as ph_msgpack_pack_to, propagating any exception
+static inline bool ph_msgpack_pack_to_raise(py_Ref val, ph_Writer writer) {
+    ph_Scope scope = ph_scope_begin();
+    py_msgpack_pack(val, writer.write, writer.ctx);
+    return ph_scope_end_raise(&scope);
+}
+
+// Unpack one message from buf, result in py_retval(). buf is read in place;
+// str and bytes payloads are copied once, into their objects.
+// Prints and clears any exception.
+static inline bool ph_msgpack_unpack(const void* buf, int len) {
+    ph_Scope scope = ph_scope_begin();
+    py_msgpack_loads((const unsigned char*)buf, len);
+    return ph_scope_end_print(&scope);
+}
+
+// Same as ph_msgpack_unpack, propagating any exception
+static inline bool ph_msgpack_unpack_raise(const void* buf, int len) {
+    ph_Scope scope = ph_scope_begin();
+    py_msgpack_loads((const unsigned char*)buf, len);
+    return ph_scope_end_raise(&scope);
+}
+
+#endif /* PK_BUILD_MODULE_MSGPACK */
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,7 @@
 #define PK_IS_PUBLIC_INCLUDE
 #include "pocketpy.h"
 
+#include <chrono>
 #include <optional>
 #include <string_view>
 #include <type_traits>
@@ -547,6 +548,36 @@ inline void def_in(const char* module_path, const char* sig, py_CFunction f) {
     py_bind(mod, sig, f);
 }
 
+// Fast "argc-based" binding: raw nativefunc, argc checked at call time only.
+// Use argc = -1 to skip the check. Keyword arguments are not supported.
+inline void def_fast(const char* name, int argc, py_CFunction f) {
+    py_GlobalRef main_mod = py_getmodule("__main__");
+    py_bindfuncn(main_mod, name, f, argc);
+}
+
+inline void def_fast_in(const char* module_path, const char* name, int argc, py_CFunction f) {
+    py_GlobalRef mod = py_getmodule(module_path);
+    if (!mod) {
+        mod = py_newmodule(module_path);
+    }
+    py_bindfuncn(mod, name, f, argc);
+}
+
+// Compile-time macros (current VM only, register before compiling scripts).
+// macro_const folds bare references to `name` into constants;
+// macro_def evaluates `NAME(literal, ...)` calls at compile time.
+inline void macro_const(const char* name, py_Ref value) {
+    py_macroconst(name, value);
+}
+
+inline void macro_const(const char* name, const Value& value) {
+    py_macroconst(name, value.ref());
+}
+
+inline void macro_def(const char* sig, py_CFunction f) {
+    py_macrobind(sig, f);
+}
+
 inline void set_global(const char* name, py_Ref val) {
     py_setglobal(py_name(name), val);
 }
@@ -567,6 +598,138 @@ inline py_GlobalRef module(const char* path) {
     return mod;
 }
 
+// Bulk binding table with compile-time signature validation.
+//
+// Usage:
+//   static constexpr ph::FuncDef kMathDefs[] = {
+//       {"add(a, b)", my_add},
+//       {"clamp(x, lo=0, hi=1)", my_clamp},
+//   };
+//   ph::module_def_table("mymath", kMathDefs);
+//
+// A malformed signature in a constexpr table fails to compile.
+
+namespace detail {
+
+constexpr bool is_ident_start(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' ||
+           static_cast<unsigned char>(c) >= 0x80;
+}
+
+constexpr bool is_ident_char(char c) {
+    return is_ident_start(c) || (c >= '0' && c <= '9');
+}
+
+constexpr const char* skip_spaces(const char* p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+constexpr const char* skip_ident(const char* p) {
+    if (!is_ident_start(*p)) return nullptr;
+    while (is_ident_char(*p)) p++;
+    return p;
+}
+
+// Skip a default value or annotation up to ',' or ')' at bracket depth 0
+constexpr const char* skip_expr(const char* p) {
+    const char* begin = p;
+    int depth = 0;
+    char quote = 0;
+    for (; *p; p++) {
+        if (quote) {
+            if (*p == '\\' && p[1]) p++;
+            else if (*p == quote) quote = 0;
+            continue;
+        }
+        if (*p == '\'' || *p == '"') quote = *p;
+        else if (*p == '(' || *p == '[' || *p == '{') depth++;
+        else if (*p == ']' || *p == '}') depth--;
+        else if (*p == ')') {
+            if (depth == 0) break;
+            depth--;
+        } else if (*p == ',' && depth == 0) break;
+        if (depth < 0) return nullptr;
+    }
+    if (quote || depth != 0 || *p == '\0') return nullptr;
+    return skip_spaces(begin) == p ? nullptr : p;
+}
+
+// Validate the shape of a decl-based signature: name(a, b=1, *args, **kwargs)
+constexpr bool valid_sig(const char* s) {
+    if (!s) return false;
+    const char* p = skip_ident(skip_spaces(s));
+    if (!p) return false;
+    p = skip_spaces(p);
+    if (*p++ != '(') return false;
+    p = skip_spaces(p);
+    while (*p != ')') {
+        if (*p == '*') p += (p[1] == '*') ? 2 : 1;
+        p = skip_ident(skip_spaces(p));
+        if (!p) return false;
+        p = skip_spaces(p);
+        if (*p == ':' || *p == '=') {
+            p = skip_expr(p + 1);
+            if (!p) return false;
+        }
+        if (*p == ',') p = skip_spaces(p + 1);
+        else if (*p != ')') return false;
+    }
+    p = skip_spaces(p + 1);
+    if (*p == '-' && p[1] == '>') return *skip_spaces(p + 2) != '\0';
+    return *p == '\0';
+}
+
+// Not constexpr: reaching this during constant evaluation is a compile error
+inline const char* invalid_signature(const char* sig) {
+    assert(false && "invalid binding signature");
+    return sig;
+}
+
+} // namespace detail
+
+struct FuncDef {
+    const char* sig;
+    py_CFunction f;
+
+    constexpr FuncDef(const char* sig_, py_CFunction f_)
+        : sig(detail::valid_sig(sig_) ? sig_ : detail::invalid_signature(sig_)), f(f_) {}
+};
+
+// Bind a table of C functions to a module (creates if needed)
+template<size_t N>
+void module_def_table(const char* module_path, const FuncDef (&table)[N]) {
+    py_FuncDef defs[N];
+    for (size_t i = 0; i < N; i++) {
+        defs[i].sig = table[i].sig;
+        defs[i].f = table[i].f;
+    }
+    py_bindtable(module(module_path), defs, static_cast<int>(N));
+}
+
+// Lazy native modules: init runs on the first import of `path` in each VM.
+// The registry is process-wide; register at startup.
+//
+// Usage:
+//   ph::register_lazy_module("mymath", [](py_GlobalRef mod) {
+//       py_bind(mod, "add(a, b)", my_add);
+//   });
+inline void register_lazy_module(const char* path, void (*init)(py_GlobalRef mod)) {
+    py_registerlazymodule(path, init);
+}
+
+// Import cache: file modules are compiled once per process and their bytecode
+// is shared across VMs. Enabled by default; toggle at startup.
+inline void set_import_cache(bool enabled) {
+    py_setimportcache(enabled);
+}
+
+// Hash seed for str hashing (dicts, sets, names) in this process.
+// Call before py_initialize; the default 0 is deterministic.
+inline void set_hash_seed(uint64_t seed) {
+    py_sethashseed(seed);
+}
+
 // ============================================================================
 // 8. Type-Safe Argument Extraction
 // ============================================================================
@@ -697,6 +860,34 @@ bool list_foreach(py_Ref list, Fn&& callback) {
     return true;
 }
 
+// Stable in-place sort by a native key computed once per element.
+// `key(py_Ref item)` returns an integral, floating-point or string key.
+template<typename Fn>
+bool list_sort_by(py_Ref list, Fn&& key, bool reverse = false,
+                  ExcPolicy policy = ExcPolicy::Print) {
+    using Fn_ = std::remove_reference_t<Fn>;
+    auto thunk = [](py_Ref item, py_OutRef out, void* ctx) -> bool {
+        using K = std::decay_t<decltype((*static_cast<Fn_*>(ctx))(item))>;
+        K k = (*static_cast<Fn_*>(ctx))(item);
+        if constexpr (std::is_same_v<K, bool>) {
+            py_newbool(out, k);
+        } else if constexpr (std::is_integral_v<K>) {
+            py_newint(out, static_cast<py_i64>(k));
+        } else if constexpr (std::is_floating_point_v<K>) {
+            py_newfloat(out, static_cast<py_f64>(k));
+        } else {
+            static_assert(std::is_convertible_v<K, std::string_view>,
+                          "sort key must be a number or a string");
+            std::string_view sv = k;
+            py_newstrv(out, {sv.data(), static_cast<int>(sv.size())});
+        }
+        return true;
+    };
+    Scope scope(policy);
+    py_list_sortby(list, thunk, const_cast<void*>(static_cast<const void*>(&key)), reverse);
+    return scope.ok();
+}
+
 // Build list from initializer list
 inline void list_from_ints(py_OutRef out, std::initializer_list<py_i64> vals) {
     py_newlistn(out, static_cast<int>(vals.size()));
@@ -739,8 +930,93 @@ void list_from(py_OutRef out, const Container& vals) {
     }
 }
 
+// Build a set (or frozenset) from any container of numbers or strings.
+// The table is sized once for vals.size() elements; duplicates collapse.
+template<typename Container>
+void set_from(py_OutRef out, const Container& vals, bool frozen = false) {
+    if (frozen) {
+        py_newfrozenset(out);
+    } else {
+        py_newset(out);
+    }
+    py_set_reserve(out, static_cast<int>(vals.size()));
+    py_TValue tmp;
+    for (const auto& val : vals) {
+        using T = std::decay_t<decltype(val)>;
+        if constexpr (std::is_integral_v<T>) {
+            py_newint(&tmp, static_cast<py_i64>(val));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            py_newfloat(&tmp, static_cast<py_f64>(val));
+        } else {
+            static_assert(std::is_convertible_v<const T&, std::string_view>,
+                          "set elements must be numbers or strings");
+            std::string_view sv = val;
+            py_newstrv(&tmp, {sv.data(), static_cast<int>(sv.size())});
+        }
+        py_set_add(out, &tmp);
+    }
+}
+
 // ============================================================================
-// 11. Debug Helpers
+// 11. Date and Time
+// ============================================================================
+//
+// datetime.datetime and datetime.timedelta hold int64 nanoseconds, so they
+// convert to and from std::chrono without a string round-trip. A naive
+// datetime counts from 1970-01-01 00:00:00, the epoch of system_clock.
+//
+// Usage:
+//   ph::new_datetime(py_r0(), std::chrono::system_clock::now());
+//   ph::new_timedelta(py_r1(), std::chrono::milliseconds(250));
+//   auto when = ph::arg<ph::TimePoint>(argv, 0);   // TypeError if not a datetime
+//
+
+using TimePoint = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>;
+
+template<typename Duration>
+void new_datetime(py_OutRef out, std::chrono::time_point<std::chrono::system_clock, Duration> tp) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch());
+    py_newdatetime(out, static_cast<py_i64>(ns.count()));
+}
+
+template<typename Rep, typename Period>
+void new_timedelta(py_OutRef out, std::chrono::duration<Rep, Period> d) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d);
+    py_newtimedelta(out, static_cast<py_i64>(ns.count()));
+}
+
+// datetime.datetime (or date) as a time point, nullopt for other types
+inline std::optional<TimePoint> as_time_point(py_Ref val) {
+    if (!py_isinstance(val, tp_date)) return std::nullopt;
+    return TimePoint(std::chrono::nanoseconds(py_todatetime(val)));
+}
+
+// datetime.timedelta as a duration, nullopt for other types
+inline std::optional<std::chrono::nanoseconds> as_duration(py_Ref val) {
+    if (!py_istype(val, tp_timedelta)) return std::nullopt;
+    return std::chrono::nanoseconds(py_totimedelta(val));
+}
+
+template<>
+struct ArgExtractor<TimePoint> {
+    static std::optional<TimePoint> get(py_StackRef argv, int i) {
+        auto tp = as_time_point(&argv[i]);
+        if (!tp) TypeError("expected 'datetime', got '%t'", argv[i].type);
+        return tp;
+    }
+};
+
+template<>
+struct ArgExtractor<std::chrono::nanoseconds> {
+    static std::optional<std::chrono::nanoseconds> get(py_StackRef argv, int i) {
+        auto d = as_duration(&argv[i]);
+        if (!d) TypeError("expected 'timedelta', got '%t'", argv[i].type);
+        return d;
+    }
+};
+
+// ============================================================================
+// 12. Debug Helpers
 // ============================================================================
 
 inline void print(py_Ref val) {
@@ -766,4 +1042,92 @@ inline const char* type_name(py_Ref val) {
     return py_tpname(py_typeof(val));
 }
 
+// ============================================================================
+// 13. VM Management
+// ============================================================================
+//
+// Per-VM resource controls; except for vm_create/vm_destroy they apply to
+// the current VM.
+
+using VMOptions = py_VMOptions;
+
+// Create a VM with its own value stack size and recursion limit; returns the
+// VM index, or -1 if no slot is free. Switch to it with py_switchvm.
+inline int vm_create(const VMOptions& opts = {}) {
+    return py_newvm(&opts);
+}
+
+inline void vm_destroy(int index) {
+    py_delvm(index);
+}
+
+// Cap the memory of the current VM (0 = unlimited); scripts that grow past
+// it get a MemoryError
+inline void vm_set_memory_limit(size_t bytes) {
+    py_setmemorylimit(bytes);
+}
+
+inline py_MemoryStats vm_memory_stats() {
+    py_MemoryStats stats;
+    py_memorystats(&stats);
+    return stats;
+}
+
+// Frame pool hits/misses and peak call depth
+inline py_VMStats vm_stats() {
+    py_VMStats stats;
+    py_vmstats(&stats);
+    return stats;
+}
+
+// ============================================================================
+// 14. Binary Serialization (msgpack)
+// ============================================================================
+//
+// Requires the msgpack module (PK_BUILD_MODULE_MSGPACK, CMake option PH_MSGPACK).
+//
+// Usage:
+//   std::string msg;
+//   ph::msgpack_pack_to(val, [&](const void* data, int size) {
+//       msg.append(static_cast<const char*>(data), size);
+//   });
+//   ph::msgpack_unpack(msg);   // result in py_retval()
+//
+
+#ifdef PK_BUILD_MODULE_MSGPACK
+
+// Pack val, passing the encoded bytes to sink(const void* data, int size) in
+// chunks; large str and bytes payloads come straight from the object. A sink
+// returning bool can abort by returning false.
+template<typename Fn>
+bool msgpack_pack_to(py_Ref val, Fn&& sink, ExcPolicy policy = ExcPolicy::Print) {
+    using Fn_ = std::remove_reference_t<Fn>;
+    auto thunk = [](void* ctx, const void* data, int size) -> bool {
+        Fn_& fn = *static_cast<Fn_*>(ctx);
+        if constexpr (std::is_same_v<decltype(fn(data, size)), void>) {
+            fn(data, size);
+            return true;
+        } else {
+            return static_cast<bool>(fn(data, size));
+        }
+    };
+    Scope scope(policy);
+    py_msgpack_pack(val, thunk, const_cast<void*>(static_cast<const void*>(&sink)));
+    return scope.ok();
+}
+
+// Unpack one message, result in py_retval(). data is read in place; str and
+// bytes payloads are copied once, into their objects.
+inline bool msgpack_unpack(const void* buf, int len, ExcPolicy policy = ExcPolicy::Print) {
+    Scope scope(policy);
+    py_msgpack_loads(static_cast<const unsigned char*>(buf), len);
+    return scope.ok();
+}
+
+inline bool msgpack_unpack(std::string_view data, ExcPolicy policy = ExcPolicy::Print) {
+    return msgpack_unpack(data.data(), static_cast<int>(data.size()), policy);
+}
+
+#endif // PK_BUILD_MODULE_MSGPACK
+
 } // namespace ph
@@ -38,17 +38,25 @@
 #define PK_ENABLE_MIMALLOC          0                
 #endif
 
+#ifndef PK_ENABLE_FROZEN_LIBS       // must be enabled from cmake
+#define PK_ENABLE_FROZEN_LIBS       0               // link a `pk_frozen_libs` table, see `py_dumpcode`
+#endif
+
 // GC min threshold
 #ifndef PK_GC_MIN_THRESHOLD         // can be overridden by cmake
     #define PK_GC_MIN_THRESHOLD     20000
 #endif
 
-// This is the maximum size of the value stack in py_TValue units
+// This is the default size of the value stack in py_TValue units
 // The actual size in bytes equals `sizeof(py_TValue) * PK_VM_STACK_SIZE`
+// Use `py_newvm` to create a VM with a different size
 #ifndef PK_VM_STACK_SIZE            // can be overridden by cmake
     #define PK_VM_STACK_SIZE        16384
 #endif
 
+// This is the smallest value stack `py_newvm` accepts, in py_TValue units
+#define PK_VM_MIN_STACK_SIZE        256
+
 // This is the maximum number of local variables in a function
 // (not recommended to change this)
 #ifndef PK_MAX_CO_VARNAMES          // can be overridden by cmake
@@ -348,6 +356,10 @@ enum py_CompileMode { EXEC_MODE, EVAL_MODE, SINGLE_MODE, RELOAD_MODE };
 
 /// Initialize pocketpy and the default VM.
 PK_API void py_initialize();
+/// Seed the hash of `str` values for this process. It is used by `hash()`, dicts, sets and names.
+/// Must be called before `py_initialize()`. The default seed is 0, giving the same hashes on every
+/// run; pass a random value to make hash-flooding inputs hard to construct.
+PK_API void py_sethashseed(uint64_t seed);
 /// Finalize pocketpy and free all VMs. This opearation is irreversible.
 /// After this call, you cannot use any function from this header anymore.
 PK_API void py_finalize();
@@ -360,6 +372,21 @@ PK_API void py_switchvm(int index);
 PK_API void py_resetvm();
 /// Reset All VMs.
 PK_API void py_resetallvm();
+
+/// Options for creating a VM with `py_newvm`.
+typedef struct py_VMOptions {
+    int stack_size;           // value stack size in slots (at least `PK_VM_MIN_STACK_SIZE`), `0` for `PK_VM_STACK_SIZE`
+    int max_recursion_depth;  // `0` for the default (1000)
+    int frame_pool_size;      // frames preallocated for calls, `0` for the default (32)
+} py_VMOptions;
+
+/// Create a VM in the first free slot without switching to it.
+/// @param opts creation options, or `NULL` for the defaults.
+/// @return the index of the new VM, or `-1` if all 16 slots are in use or `opts->stack_size` is
+/// below `PK_VM_MIN_STACK_SIZE`.
+PK_API int py_newvm(const py_VMOptions* opts);
+/// Delete a VM and free its slot. The default VM and the current VM cannot be deleted.
+PK_API void py_delvm(int index);
 /// Get the current VM context. This is used for user-defined data.
 PK_API void* py_getvmctx();
 /// Set the current VM context. This is used for user-defined data.
@@ -376,6 +403,37 @@ PK_API void py_sys_settrace(py_TraceFunc func, bool reset);
 /// Invoke the garbage collector.
 PK_API int py_gc_collect();
 
+/// Memory usage of a VM in bytes.
+typedef struct py_MemoryStats {
+    size_t heap_size;       // live objects: small objects (block-rounded) plus large objects
+    size_t str_size;        // part of `heap_size` held by str objects
+    size_t buffer_size;     // list, dict and attribute storage owned by objects
+    size_t stack_size;      // value stack and frames in use
+    size_t stack_capacity;  // value stack reserved for the VM
+    size_t used_size;       // `heap_size + buffer_size`, which counts against the limit
+    size_t peak_size;       // peak of `used_size`
+    size_t limit;           // 0 for unlimited
+} py_MemoryStats;
+
+/// Limit the memory of the current VM. `0` means unlimited.
+/// Allocations beyond the limit raise `MemoryError` in the running script after a full collection.
+PK_API void py_setmemorylimit(size_t bytes);
+/// Get the memory usage of the current VM. Counters are exact after a collection.
+PK_API void py_memorystats(py_MemoryStats* out);
+
+/// Call statistics of a VM.
+typedef struct py_VMStats {
+    int frame_pool_size;        // frames preallocated in the pool
+    int64_t frame_pool_hits;    // frames taken from the pool
+    int64_t frame_pool_misses;  // frames allocated with `PK_MALLOC` because the pool was empty
+    int frame_fallback_live;    // frames currently allocated outside the pool
+    int recursion_depth;        // current call depth
+    int peak_recursion_depth;   // deepest call depth so far
+} py_VMStats;
+
+/// Get the call statistics of the current VM.
+PK_API void py_vmstats(py_VMStats* out);
+
 /// Wrapper for `PK_MALLOC(size)`.
 PK_API void* py_malloc(size_t size);
 /// Wrapper for `PK_REALLOC(ptr, size)`.
@@ -506,6 +564,20 @@ PK_API c11_sv py_name2sv(py_Name);
 /// @param sig signature of the function. e.g. `add(x, y)`.
 /// @param f function to bind.
 PK_API void py_bind(py_Ref obj, const char* sig, py_CFunction f);
+/// A table entry for `py_bindtable`.
+typedef struct py_FuncDef {
+    /// signature of the function. e.g. `add(x, y)`.
+    const char* sig;
+    /// function to bind.
+    py_CFunction f;
+} py_FuncDef;
+
+/// Bind multiple functions to the object via "decl-based" style.
+/// All signatures are compiled in a single pass and the object's dict is presized.
+/// @param obj the target object.
+/// @param defs table of functions.
+/// @param n number of entries in `defs`.
+PK_API void py_bindtable(py_Ref obj, const py_FuncDef* defs, int n);
 /// Bind a method to type via "argc-based" style.
 /// @param type the target type.
 /// @param name name of the method.
@@ -521,6 +593,14 @@ PK_API void py_bindstaticmethod(py_Type type, const char* name, py_CFunction f);
 /// @param name name of the function.
 /// @param f function to bind.
 PK_API void py_bindfunc(py_Ref obj, const char* name, py_CFunction f);
+/// Bind a function to the object via "argc-based" style with a fixed arity.
+/// The argument count is checked at call time before `f` is invoked, also when `f` is
+/// a magic method called by an operator.
+/// @param obj the target object.
+/// @param name name of the function.
+/// @param f function to bind.
+/// @param argc expected number of arguments. Use `-1` to skip the check.
+PK_API void py_bindfuncn(py_Ref obj, const char* name, py_CFunction f, int argc);
 /// Bind a property to type.
 /// @param type the target type.
 /// @param name name of the property.
@@ -532,6 +612,9 @@ PK_API void
 PK_API void py_bindmagic(py_Type type, py_Name name, py_CFunction f);
 /// Bind a compile-time function via "decl-based" style.
 PK_API void py_macrobind(const char* sig, py_CFunction f);
+/// Bind a compile-time constant.
+/// References to `name` in code compiled afterwards are folded into constants.
+PK_API void py_macroconst(const char* name, py_Ref val);
 /// Get a compile-time function by name.
 PK_API py_ItemRef py_macroget(py_Name name);
 
@@ -625,6 +708,8 @@ PK_API void py_tphookattributes(py_Type type,
 #define py_islist(self) py_istype(self, tp_list)
 #define py_istuple(self) py_istype(self, tp_tuple)
 #define py_isdict(self) py_istype(self, tp_dict)
+#define py_isset(self) py_istype(self, tp_set)
+#define py_isfrozenset(self) py_istype(self, tp_frozenset)
 #define py_isnil(self) py_istype(self, 0)
 #define py_isnone(self) py_istype(self, tp_NoneType)
 
@@ -852,6 +937,22 @@ PK_API bool py_delitem(py_Ref self, py_Ref key) PY_RAISE;
 PK_API py_GlobalRef py_getmodule(const char* path);
 /// Create a new module.
 PK_API py_GlobalRef py_newmodule(const char* path);
+/// Register a native module that is created on first import.
+/// The registry is process-wide: `init` runs once per VM, on the first `import path` there.
+/// Register all lazy modules before VMs run on other threads.
+/// @param path module path. e.g. `mylib.math`.
+/// @param init function that populates the newly created module.
+PK_API void py_registerlazymodule(const char* path, void (*init)(py_GlobalRef mod));
+/// Enable or disable the process-wide cache of modules loaded via `importfile`. Enabled by default.
+/// A cached module is compiled once; all VMs share its bytecode and rebuild only its constants.
+/// The cache is keyed by filename and source, so edited files are recompiled.
+/// Builtin python sources, stdlib modules and bound signatures are always shared this way.
+PK_API void py_setimportcache(bool enabled);
+/// Compile `source` and serialize its bytecode, so a build can link it into the code cache.
+/// With `PK_ENABLE_FROZEN_LIBS`, the build provides a `pk_frozen_libs` table of these dumps and
+/// builtin python sources with a matching filename and source are loaded instead of compiled.
+/// @return a buffer of `*size` bytes to be freed with `PK_FREE`, or NULL on error.
+PK_API unsigned char* py_dumpcode(const char* source, const char* filename, int* size) PY_RAISE;
 /// Reload an existing module.
 PK_API bool py_importlib_reload(py_Ref module) PY_RAISE PY_RETURN;
 /// Import a module.
@@ -940,6 +1041,15 @@ PK_API py_ItemRef py_list_emplace(py_Ref self);
 PK_API void py_list_clear(py_Ref self);
 PK_API void py_list_insert(py_Ref self, int i, py_Ref val);
 
+/// Native sort key: write the key of `item` into `out`.
+typedef bool (*py_KeyFunc)(py_Ref item, py_OutRef out, void* ctx) PY_RAISE;
+/// Stable in-place sort, same as `list.sort(key, reverse)`.
+/// Each key is computed once before sorting.
+/// @param key a callable, or `NULL` / `None` to compare the elements themselves.
+PK_API bool py_list_sort(py_Ref self, py_Ref key, bool reverse) PY_RAISE;
+/// Stable in-place sort by keys computed once per element by a native function.
+PK_API bool py_list_sortby(py_Ref self, py_KeyFunc key, void* ctx, bool reverse) PY_RAISE;
+
 /************* PyDict *************/
 
 /// Create an empty `dict`.
@@ -970,6 +1080,26 @@ PK_API bool
 /// noexcept
 PK_API int py_dict_len(py_Ref self);
 
+/************* PySet *************/
+
+/// Create an empty `set`.
+PK_API void py_newset(py_OutRef);
+/// Create an empty `frozenset`. Fill it with `py_set_add()` before handing it out.
+PK_API void py_newfrozenset(py_OutRef);
+/// Make room for `n` elements in total, so adding them does not rehash.
+PK_API void py_set_reserve(py_Ref self, int n);
+/// Works on both `set` and `frozenset`.
+/// -1: error, 0: already present, 1: added
+PK_API int py_set_add(py_Ref self, py_Ref key) PY_RAISE;
+/// -1: error, 0: not found, 1: found
+PK_API int py_set_contains(py_Ref self, py_Ref key) PY_RAISE;
+/// -1: error, 0: not found, 1: found (and removed)
+PK_API int py_set_discard(py_Ref self, py_Ref key) PY_RAISE;
+/// true: success, false: error
+PK_API bool py_set_apply(py_Ref self, bool (*f)(py_Ref key, void* ctx), void* ctx) PY_RAISE;
+/// noexcept
+PK_API int py_set_len(py_Ref self);
+
 /************* PySlice *************/
 
 /// Create an UNINITIALIZED `slice` object.
@@ -1006,6 +1136,16 @@ PK_API c11_vec3i py_tovec3i(py_Ref self);
 PK_API c11_mat3x3* py_tomat3x3(py_Ref self);
 PK_API c11_color32 py_tocolor32(py_Ref self);
 
+/************* datetime module *************/
+/// Create a `datetime.timedelta` of `ns` nanoseconds.
+PK_API void py_newtimedelta(py_OutRef out, py_i64 ns);
+/// Create a naive `datetime.datetime`, `ns` nanoseconds after 1970-01-01 00:00:00.
+PK_API void py_newdatetime(py_OutRef out, py_i64 ns);
+/// Get the nanoseconds of a `datetime.timedelta`.
+PK_API py_i64 py_totimedelta(py_Ref self);
+/// Get the nanoseconds since 1970-01-01 00:00:00 of a `datetime.datetime` or `datetime.date`.
+PK_API py_i64 py_todatetime(py_Ref self);
+
 /************* json module *************/
 /// Python equivalent to `json.dumps(val)`.
 PK_API bool py_json_dumps(py_Ref val, int indent) PY_RAISE PY_RETURN;
@@ -1018,6 +1158,17 @@ PK_API bool py_pickle_dumps(py_Ref val) PY_RAISE PY_RETURN;
 /// Python equivalent to `pickle.loads(val)`.
 PK_API bool py_pickle_loads(const unsigned char* data, int size) PY_RAISE PY_RETURN;
 
+/************* msgpack module *************/
+/// Receives `size` bytes of output. Return false (optionally raising) to abort.
+typedef bool (*py_WriteFunc)(void* ctx, const void* data, int size) PY_RAISE;
+/// Python equivalent to `msgpack.packb(val)`. Requires `PK_BUILD_MODULE_MSGPACK`.
+PK_API bool py_msgpack_dumps(py_Ref val) PY_RAISE PY_RETURN;
+/// Pack `val` as msgpack, passing the encoded bytes to `write` in chunks of a few KB.
+/// Large `str` and `bytes` payloads are passed directly from the object's storage.
+PK_API bool py_msgpack_pack(py_Ref val, py_WriteFunc write, void* ctx) PY_RAISE;
+/// Python equivalent to `msgpack.unpackb(data)`. Reads `data` in place.
+PK_API bool py_msgpack_loads(const unsigned char* data, int size) PY_RAISE PY_RETURN;
+
 /************* pkpy module *************/
 /// Begin the watchdog with `timeout` in milliseconds.
 /// `PK_ENABLE_WATCHDOG` must be defined to `1` to use this feature.
@@ -1131,6 +1282,29 @@ enum py_PredefinedType {
     tp_array2d,
     tp_array2d_view,
     tp_chunked_array2d,
+    /* collections */
+    tp_deque,
+    tp_deque_iterator,
+    /* functools */
+    tp_partial,
+    tp_lru_cache_wrapper,
+    tp_cache_info,
+    /* datetime */
+    tp_timedelta,
+    tp_date,
+    tp_datetime,
+    /* struct */
+    tp_Struct,
+    tp_Struct_iterator,
+    /* re */
+    tp_re_Pattern,
+    tp_re_Match,
+    tp_re_Scanner,
+    /* added later, kept at the end so earlier values stay stable */
+    tp_MemoryError,
+    tp_set,
+    tp_frozenset,
+    tp_set_iterator,  // 1 slot
 };
 
 #ifdef __cplusplus
@@ -196,6 +196,345 @@ TEST(def_in_module) {
     ASSERT(py_tobool(py_retval()) == true);
 }
 
+// Fast-bound function (no PY_CHECK_ARGC, arity is checked by the VM)
+static bool cfunc_mul(int argc, py_StackRef argv) {
+    (void)argc;
+    PH_ARG_INT(0, a);
+    PH_ARG_INT(1, b);
+    PH_RETURN_INT(a * b);
+}
+
+TEST(def_fast) {
+    ph_def_fast("c_mul", 2, cfunc_mul);
+
+    bool ok = ph_eval("c_mul(6, 7)");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 42);
+}
+
+TEST(def_fast_wrong_argc) {
+    ph_def_fast("c_mul2", 2, cfunc_mul);
+
+    bool ok = ph_eval("c_mul2(1)");
+    ASSERT(!ok);
+    ASSERT(!py_checkexc());
+
+    ok = ph_eval("c_mul2(1, 2, 3)");
+    ASSERT(!ok);
+    ASSERT(!py_checkexc());
+
+    // The check raises TypeError before cfunc_mul reads its arguments
+    ASSERT(!ph_eval_raise("c_mul2(1)"));
+    ASSERT(py_matchexc(tp_TypeError));
+    py_clearexc(NULL);
+    ASSERT(!ph_eval_raise("c_mul2(1, 2, 3)"));
+    ASSERT(py_matchexc(tp_TypeError));
+    py_clearexc(NULL);
+}
+
+static bool cfunc_always(int argc, py_StackRef argv) {
+    (void)argc;
+    (void)argv;
+    py_newbool(py_retval(), true);
+    return true;
+}
+
+TEST(def_fast_magic_method) {
+    // Subscripts and `in` call a native magic method directly; the arity is still checked
+    py_Type t = py_newtype("FastItems", tp_object, NULL, NULL);
+    py_bindfuncn(py_tpobject(t), "__getitem__", cfunc_always, 3);
+    py_bindfuncn(py_tpobject(t), "__contains__", cfunc_always, 2);
+    py_newobject(py_r0(), t, 0, 0);
+    ph_setglobal("fast_items", py_r0());
+
+    ASSERT(!ph_eval_raise("fast_items[2]"));
+    ASSERT(py_matchexc(tp_TypeError));
+    py_clearexc(NULL);
+
+    ASSERT(ph_eval("2 in fast_items"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(def_fast_unchecked) {
+    ph_def_fast("c_power2", -1, cfunc_power);
+
+    bool ok = ph_eval("c_power2(5)");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 25);
+
+    ok = ph_eval("c_power2(2, 3)");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 8);
+}
+
+TEST(def_fast_py_call) {
+    ph_def_fast("c_mul3", 2, cfunc_mul);
+    py_ItemRef fn = ph_getglobal("c_mul3");
+    ASSERT(fn != NULL);
+
+    ph_Result r = ph_call(fn, 1, ph_tmp_int(3));
+    ASSERT(!r.ok);
+    ASSERT(!py_checkexc());
+
+    py_newint(py_getreg(1), 3);
+    py_newint(py_getreg(2), 4);
+    r = ph_call(fn, 2, py_getreg(1));
+    ASSERT(r.ok);
+    ASSERT_EQ(py_toint(r.val), 12);
+}
+
+TEST(def_fast_in_module) {
+    ph_def_fast_in("fastmod", "mul", 2, cfunc_mul);
+
+    bool ok = ph_exec("import fastmod", "<test>");
+    ASSERT(ok);
+
+    ok = ph_eval("fastmod.mul(3, 5)");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 15);
+}
+
+// Compile-time function: square of a literal int
+static bool cfunc_square(int argc, py_StackRef argv) {
+    PY_CHECK_ARGC(1);
+    PH_ARG_INT(0, x);
+    PH_RETURN_INT(x * x);
+}
+
+TEST(macro_const_folded) {
+    ph_macro_const("FEATURE_FLAG", ph_tmp_bool(true));
+    ph_macro_const("BUILD_NAME", ph_tmp_str("release"));
+
+    bool ok = ph_exec("def flag(): return FEATURE_FLAG\n"
+                      "def build(): return BUILD_NAME", "<test>");
+    ASSERT(ok);
+
+    // A global with the same name does not affect the folded constant
+    ph_setglobal("FEATURE_FLAG", ph_tmp_bool(false));
+    ok = ph_eval("flag()");
+    ASSERT(ok);
+    ASSERT(py_tobool(py_retval()) == true);
+
+    ok = ph_eval("build()");
+    ASSERT(ok);
+    ASSERT_STR_EQ(py_tostr(py_retval()), "release");
+}
+
+TEST(macro_const_readonly) {
+    ph_macro_const("MAX_USERS", ph_tmp_int(64));
+
+    bool ok = ph_exec("MAX_USERS = 1", "<test>");
+    ASSERT(!ok);
+    ASSERT(!py_checkexc());
+
+    ok = ph_eval("MAX_USERS * 2");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 128);
+}
+
+TEST(macro_const_not_shadowed) {
+    ph_macro_const("LIMIT", ph_tmp_int(10));
+
+    // Every reference to LIMIT is folded, so binding it is a syntax error
+    const char* sources[] = {
+        "def f(LIMIT): return LIMIT",
+        "g = lambda LIMIT: LIMIT",
+        "x = [LIMIT for LIMIT in range(2)]",
+        "for LIMIT in range(2): pass",
+        "def LIMIT(): pass",
+        "class LIMIT: pass",
+        "import math as LIMIT",
+        "from math import pi as LIMIT",
+        "try:\n    pass\nexcept Exception as LIMIT:\n    pass",
+    };
+    for(int i = 0; i < (int)PH_COUNTOF(sources); i++) {
+        ASSERT(!ph_exec(sources[i], "<test>"));
+        ASSERT(!py_checkexc());
+    }
+
+    ASSERT(ph_eval("[LIMIT for i in range(2)] == [10, 10]"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(macro_def_compile_time_call) {
+    ph_macro_def("SQUARE(x)", cfunc_square);
+
+    bool ok = ph_eval("SQUARE(12)");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 144);
+
+    // Non-literal arguments are rejected at compile time
+    ok = ph_eval("SQUARE(len('ab'))");
+    ASSERT(!ok);
+    ASSERT(!py_checkexc());
+}
+
+TEST(module_def_table) {
+    static const ph_FuncDef defs[] = {
+        {"add(a, b)", cfunc_add},
+        {"greet(name, greeting=None)", cfunc_greet},
+        {"power(base, exp=None)", cfunc_power},
+    };
+    ph_module_def_table("tablemod", defs, PH_COUNTOF(defs));
+
+    bool ok = ph_exec("import tablemod", "<test>");
+    ASSERT(ok);
+
+    ok = ph_eval("tablemod.add(2, 3)");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 5);
+
+    ok = ph_eval("tablemod.greet('World', greeting='Hey')");
+    ASSERT(ok);
+    ASSERT_STR_EQ(py_tostr(py_retval()), "Hey, World!");
+
+    ok = ph_eval("tablemod.power(4)");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 16);
+}
+
+TEST(module_def_table_existing_module) {
+    ph_def_in("tablemod2", "first(n)", cfunc_is_positive);
+
+    static const ph_FuncDef defs[] = {
+        {"second(a, b)", cfunc_add},
+    };
+    ph_module_def_table("tablemod2", defs, PH_COUNTOF(defs));
+
+    bool ok = ph_exec("import tablemod2", "<test>");
+    ASSERT(ok);
+    ok = ph_eval("tablemod2.first(1) and tablemod2.second(1, 1) == 2");
+    ASSERT(ok);
+    ASSERT(py_tobool(py_retval()) == true);
+}
+
+static int g_lazy_init_count = 0;
+
+static void init_lazymod(py_GlobalRef mod) {
+    g_lazy_init_count++;
+    py_bind(mod, "add(a, b)", cfunc_add);
+}
+
+TEST(lazy_module) {
+    ph_register_lazy_module("lazymod", init_lazymod);
+    ASSERT_EQ(g_lazy_init_count, 0);
+    ASSERT(py_getmodule("lazymod") == NULL);
+
+    bool ok = ph_exec("import lazymod\nimport lazymod", "<test>");
+    ASSERT(ok);
+    ASSERT_EQ(g_lazy_init_count, 1);
+
+    ok = ph_eval("lazymod.add(20, 22)");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(py_retval()), 42);
+}
+
+TEST(lazy_module_other_vm) {
+    int before = g_lazy_init_count;
+
+    py_switchvm(1);
+    ASSERT(py_getmodule("lazymod") == NULL);
+    bool ok = ph_exec("import lazymod\nx = lazymod.add(1, 2)", "<test>");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(ph_getglobal("x")), 3);
+    py_switchvm(0);
+
+    ASSERT_EQ(g_lazy_init_count, before + 1);
+}
+
+static const char* g_cachedmod_src =
+    "LONG = 'a constant long enough to live on the heap'\n"
+    "def greet(name, sep=', ', tail=('!', 'a default tuple with a heap string')):\n"
+    "    'Greets someone by name.'\n"
+    "    return 'hello' + sep + name + tail[0]\n"
+    "def make_adder(n):\n"
+    "    def add(x):\n"
+    "        return x + n + 1000000\n"
+    "    return add\n";
+
+static char* importfile_cachedmod(const char* path) {
+    if (strcmp(path, "cachedmod.py") != 0) return NULL;
+    size_t size = strlen(g_cachedmod_src) + 1;
+    char* data = malloc(size);
+    memcpy(data, g_cachedmod_src, size);
+    return data;
+}
+
+static void check_cachedmod(void) {
+    char* (*saved)(const char*) = py_callbacks()->importfile;
+    py_callbacks()->importfile = importfile_cachedmod;
+    bool ok = ph_exec("import cachedmod", "<test>");
+    py_callbacks()->importfile = saved;
+    ASSERT(ok);
+    py_gc_collect();
+    ok = ph_eval("cachedmod.greet('bob') + cachedmod.LONG + str(cachedmod.make_adder(1)(1))");
+    ASSERT(ok);
+    ASSERT_STR_EQ(py_tostr(py_retval()),
+                  "hello, bob!a constant long enough to live on the heap1000002");
+    ok = ph_eval("cachedmod.greet.__doc__");
+    ASSERT(ok);
+    ASSERT_STR_EQ(py_tostr(py_retval()), "Greets someone by name.");
+}
+
+TEST(import_cache_shared_across_vms) {
+    check_cachedmod();
+
+    py_switchvm(2);
+    check_cachedmod();
+    py_switchvm(0);
+}
+
+TEST(import_cache_source_changed) {
+    g_cachedmod_src = "LONG = 'the file was edited after the first import'\n";
+
+    py_switchvm(3);
+    char* (*saved)(const char*) = py_callbacks()->importfile;
+    py_callbacks()->importfile = importfile_cachedmod;
+    bool ok = ph_exec("import cachedmod", "<test>");
+    py_callbacks()->importfile = saved;
+    ASSERT(ok);
+    ok = ph_eval("cachedmod.LONG");
+    ASSERT(ok);
+    ASSERT_STR_EQ(py_tostr(py_retval()), "the file was edited after the first import");
+    py_switchvm(0);
+}
+
+static bool import_cachedmod(const char* src) {
+    g_cachedmod_src = src;
+    char* (*saved)(const char*) = py_callbacks()->importfile;
+    py_callbacks()->importfile = importfile_cachedmod;
+    bool ok = ph_exec("import cachedmod", "<test>");
+    py_callbacks()->importfile = saved;
+    return ok;
+}
+
+TEST(import_cache_two_versions) {
+    // VM 4 keeps a function from the first version while VM 5 imports the second one,
+    // which retires the first cache entry; the borrowed bytecode must stay valid
+    py_switchvm(4);
+    ASSERT(import_cachedmod("def version(n=1):\n    return 'first' * n\n"));
+    ASSERT(ph_exec("version = cachedmod.version\ndel cachedmod", "<test>"));
+
+    py_switchvm(5);
+    ASSERT(import_cachedmod("def version(n=1):\n    return 'second' * n\n"));
+    ASSERT(ph_eval("cachedmod.version(2)"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "secondsecond");
+
+    py_switchvm(4);
+    py_gc_collect();
+    ASSERT(ph_eval("version(2)"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "firstfirst");
+    py_resetvm();  // drops the last reference to the first version
+    py_switchvm(0);
+
+    // going back to the first source compiles it again
+    py_switchvm(6);
+    ASSERT(import_cachedmod("def version(n=1):\n    return 'first' * n\n"));
+    ASSERT(ph_eval("cachedmod.version()"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "first");
+    py_switchvm(0);
+}
+
 TEST_SUITE_BEGIN("Function Binding")
     RUN_TEST(bind_add);
     RUN_TEST(bind_divide);
@@ -210,4 +549,21 @@ TEST_SUITE_BEGIN("Function Binding")
     RUN_TEST(setglobal_getglobal);
     RUN_TEST(getglobal_undefined);
     RUN_TEST(def_in_module);
+    RUN_TEST(def_fast);
+    RUN_TEST(def_fast_wrong_argc);
+    RUN_TEST(def_fast_magic_method);
+    RUN_TEST(def_fast_unchecked);
+    RUN_TEST(def_fast_py_call);
+    RUN_TEST(def_fast_in_module);
+    RUN_TEST(macro_const_folded);
+    RUN_TEST(macro_const_readonly);
+    RUN_TEST(macro_const_not_shadowed);
+    RUN_TEST(macro_def_compile_time_call);
+    RUN_TEST(module_def_table);
+    RUN_TEST(module_def_table_existing_module);
+    RUN_TEST(lazy_module);
+    RUN_TEST(lazy_module_other_vm);
+    RUN_TEST(import_cache_shared_across_vms);
+    RUN_TEST(import_cache_source_changed);
+    RUN_TEST(import_cache_two_versions);
 TEST_SUITE_END()
@@ -325,6 +325,57 @@ TEST(callmethod_r_raise_exception) {
     py_clearexc(NULL);
 }
 
+TEST(partial_forwards_args_and_keywords) {
+    ASSERT(ph_exec(
+        "from functools import partial, reduce\n"
+        "def f(a, b, c=0, d=0): return (a, b, c, d)\n"
+        "p = partial(partial(f, 1), c=3)\n"
+        "r = (\n"
+        "    p(2), p(2, c=9, d=4), p.func is f, p.args, p.keywords,\n"
+        "    reduce(lambda x, y: x * y, range(1, 6)),\n"
+        "    reduce(lambda x, y: x + y, [], 'e'),\n"
+        ")",
+        "<test>"
+    ));
+    ASSERT(ph_eval("r == ((1, 2, 3, 0), (1, 2, 9, 4), True, (1,), {'c': 3}, 120, 'e')"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(lru_cache_evicts_least_recent) {
+    ASSERT(ph_exec(
+        "from functools import lru_cache\n"
+        "calls = []\n"
+        "@lru_cache(maxsize=2)\n"
+        "def sq(x):\n"
+        "    calls.append(x)\n"
+        "    return x * x\n"
+        "class C:\n"
+        "    @lru_cache\n"
+        "    def twice(self, x): return 2 * x\n"
+        "sq(1); sq(2); sq(1); sq(3); sq(2)\n"
+        "r = (calls, sq.cache_info().hits, sq.cache_info().currsize, C().twice(4))\n"
+        "sq.cache_clear()\n"
+        "info = repr(sq.cache_info())",
+        "<test>"
+    ));
+    ASSERT(ph_eval("r == ([1, 2, 3, 2], 1, 2, 8)"));
+    ASSERT(py_tobool(py_retval()));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("info"), ""),
+                  "CacheInfo(hits=0, misses=0, maxsize=2, currsize=0)");
+}
+
+TEST(lru_cache_rejects_unhashable) {
+    ASSERT(ph_exec(
+        "import functools\n"
+        "@functools.cache\n"
+        "def ident(x): return x",
+        "<test>"
+    ));
+    ASSERT(!ph_exec_raise("ident([1])", "<test>"));
+    ASSERT(py_matchexc(tp_TypeError));
+    py_clearexc(NULL);
+}
+
 TEST_SUITE_BEGIN("Function Calls")
     RUN_TEST(call0_builtin);
     RUN_TEST(call1_simple);
@@ -352,4 +403,7 @@ TEST_SUITE_BEGIN("Function Calls")
     RUN_TEST(call_r_raise_exception);
     RUN_TEST(callmethod_r_raise_success);
     RUN_TEST(callmethod_r_raise_exception);
+    RUN_TEST(partial_forwards_args_and_keywords);
+    RUN_TEST(lru_cache_evicts_least_recent);
+    RUN_TEST(lru_cache_rejects_unhashable);
 TEST_SUITE_END()
@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
 #include <vector>
 
 static int tests_passed = 0;
@@ -256,6 +257,74 @@ TEST(binding_def) {
     ASSERT_EQ(py_toint(result.value()), 300);
 }
 
+TEST(binding_def_fast) {
+    ph::def_fast("native_add_fast", 2, native_add);
+    auto result = ph::eval("native_add_fast(1, 2)");
+    ASSERT(result.ok());
+    ASSERT_EQ(py_toint(result.value()), 3);
+
+    auto bad = ph::eval("native_add_fast(1)", ph::ExcPolicy::Silent);
+    ASSERT(!bad.ok());
+}
+
+static bool native_neg(int argc, py_StackRef argv) {
+    PY_CHECK_ARGC(1);
+    auto x = ph::arg<py_i64>(argv, 0);
+    if (!x) return false;
+    return ph::ret_int(-*x);
+}
+
+// Signatures are validated at compile time
+static_assert(ph::detail::valid_sig("add(a, b)"));
+static_assert(ph::detail::valid_sig("f()"));
+static_assert(ph::detail::valid_sig("f(x, y=(1, 2), *args, z='a,)', **kw) -> int"));
+static_assert(!ph::detail::valid_sig("add(a, b"));
+static_assert(!ph::detail::valid_sig("1add(a)"));
+static_assert(!ph::detail::valid_sig("add(a,, b)"));
+static_assert(!ph::detail::valid_sig("add(a=)"));
+
+static constexpr ph::FuncDef kTableDefs[] = {
+    {"add(a, b)", native_add},
+    {"neg(x)", native_neg},
+};
+
+TEST(binding_module_def_table) {
+    ph::module_def_table("cpptable", kTableDefs);
+    ASSERT(ph::exec("import cpptable"));
+    auto result = ph::eval("cpptable.add(cpptable.neg(5), 8)");
+    ASSERT(result.ok());
+    ASSERT_EQ(py_toint(result.value()), 3);
+}
+
+TEST(binding_lazy_module) {
+    ph::register_lazy_module("cpplazy", [](py_GlobalRef mod) {
+        py_bind(mod, "neg(x)", native_neg);
+    });
+    ASSERT(py_getmodule("cpplazy") == nullptr);
+    ASSERT(ph::exec("import cpplazy"));
+    auto result = ph::eval("cpplazy.neg(7)");
+    ASSERT(result.ok());
+    ASSERT_EQ(py_toint(result.value()), -7);
+}
+
+TEST(binding_import_cache_disabled) {
+    ph::set_import_cache(false);
+    auto saved = py_callbacks()->importfile;
+    py_callbacks()->importfile = [](const char* path) -> char* {
+        if (strcmp(path, "cppfilemod.py") != 0) return nullptr;
+        const char src[] = "def twice(x):\n    return x * 2\n";
+        char* data = static_cast<char*>(malloc(sizeof(src)));
+        memcpy(data, src, sizeof(src));
+        return data;
+    };
+    ASSERT(ph::exec("import cppfilemod"));
+    py_callbacks()->importfile = saved;
+    ph::set_import_cache(true);
+    auto result = ph::eval("cppfilemod.twice(21)");
+    ASSERT(result.ok());
+    ASSERT_EQ(py_toint(result.value()), 42);
+}
+
 TEST(binding_set_get_global) {
     auto v = ph::Value::integer(12345, 0);
     ph::set_global("test_var", v);
@@ -343,6 +412,89 @@ TEST(list_from_container) {
     ASSERT_EQ(py_toint(result.value()), 600);
 }
 
+TEST(list_sort_by) {
+    ASSERT(ph::exec("people = [('bob', 31.5), ('amy', 24.0), ('cat', 40.25)]"));
+    py_ItemRef people = ph::get_global("people");
+
+    ASSERT(ph::list_sort_by(people, [](py_Ref item) {
+        return py_tofloat(py_tuple_getitem(item, 1));
+    }));
+    auto first = ph::eval("people[0][0]");
+    ASSERT(first.ok());
+    ASSERT_STREQ(py_tostr(first.value()), "amy");
+
+    ASSERT(ph::list_sort_by(people, [](py_Ref item) {
+        return std::string(py_tostr(py_tuple_getitem(item, 0)));
+    }, true));
+    auto names = ph::eval("'|'.join([p[0] for p in people])");
+    ASSERT(names.ok());
+    ASSERT_STREQ(py_tostr(names.value()), "cat|bob|amy");
+}
+
+TEST(set_from_container) {
+    std::vector<std::string> tags = {"red", "green", "red"};
+    ph::set_from(py_r0(), tags);
+    ASSERT(py_isset(py_r0()));
+    ASSERT_EQ(py_set_len(py_r0()), 2);
+
+    std::vector<int> ids = {3, 1, 2};
+    ph::set_from(py_r1(), ids, true);
+    ph::set_global("frozen_ids", py_r1());
+    auto hit = ph::eval("{frozenset([1, 2, 3]): 'hit'}[frozen_ids]");
+    ASSERT(hit.ok());
+    ASSERT_STREQ(py_tostr(hit.value()), "hit");
+}
+
+// ============================================================================
+// Date and Time Tests
+// ============================================================================
+
+TEST(datetime_chrono_roundtrip) {
+    using namespace std::chrono;
+    auto start = ph::TimePoint(seconds(1710073845));  // 2024-03-10 12:30:45
+    ph::new_datetime(py_r0(), start);
+    ph::new_timedelta(py_r1(), milliseconds(1500));
+    ph::set_global("start", py_r0());
+    ph::set_global("step", py_r1());
+
+    auto iso = ph::eval("str(start + step * 2)");
+    ASSERT(iso.ok());
+    ASSERT_STREQ(py_tostr(iso.value()), "2024-03-10 12:30:48");
+
+    auto end = ph::eval("start + step");
+    ASSERT(end.ok());
+    auto tp = ph::as_time_point(end.value());
+    ASSERT(tp.has_value());
+    ASSERT(*tp - start == milliseconds(1500));
+    ASSERT(!ph::as_duration(end.value()).has_value());
+
+    // the system clock converts at its own resolution
+    ph::new_datetime(py_r2(), system_clock::now());
+    ASSERT(ph::as_time_point(py_r2()).has_value());
+}
+
+static bool native_elapsed_ms(int argc, py_StackRef argv) {
+    PY_CHECK_ARGC(2);
+
+    auto a = ph::arg<ph::TimePoint>(argv, 0);
+    if (!a) return false;
+    auto b = ph::arg<ph::TimePoint>(argv, 1);
+    if (!b) return false;
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(*b - *a);
+    return ph::ret_int(ms.count());
+}
+
+TEST(datetime_arg_extraction) {
+    ph::def("elapsed_ms(a, b)", native_elapsed_ms);
+    ASSERT(ph::exec("import datetime"));
+    auto ms = ph::eval(
+        "elapsed_ms(datetime.datetime(2024, 1, 1), datetime.datetime(2024, 1, 1, 0, 1))");
+    ASSERT(ms.ok());
+    ASSERT_EQ(py_toint(ms.value()), 60000);
+    ASSERT(!ph::eval("elapsed_ms(1, 2)", ph::ExcPolicy::Silent).ok());
+}
+
 // ============================================================================
 // Result Tests
 // ============================================================================
@@ -380,6 +532,70 @@ TEST(repr) {
     ASSERT_STREQ(r, "42");
 }
 
+TEST(vm_memory_limit) {
+    ph::vm_set_memory_limit(4 * 1024 * 1024);
+    auto result = ph::eval("len([0] * 10000000)");
+    ASSERT(!result.ok());
+    ASSERT(ph::vm_memory_stats().limit == 4 * 1024 * 1024);
+    ph::vm_set_memory_limit(0);
+    ASSERT(ph::exec("big = [0] * 1000000"));
+    auto stats = ph::vm_memory_stats();
+    ASSERT(stats.used_size >= 1000000 * sizeof(py_TValue));
+    ASSERT(stats.peak_size >= stats.used_size);
+    ASSERT(ph::exec("del big"));
+}
+
+TEST(vm_create) {
+    ph::VMOptions opts{};
+    opts.stack_size = 512;
+    opts.frame_pool_size = 64;
+    int index = ph::vm_create(opts);
+    ASSERT(index > 0);
+    py_switchvm(index);
+    ASSERT(ph::vm_memory_stats().stack_capacity < 32 * 1024);
+    ASSERT_EQ(ph::vm_stats().frame_pool_size, 64);
+    auto result = ph::eval("sum(range(10))");
+    ASSERT(result.ok());
+    ASSERT_EQ(py_toint(result.value()), 45);
+    py_switchvm(0);
+    ph::vm_destroy(index);
+}
+
+#ifdef PK_BUILD_MODULE_MSGPACK
+// ============================================================================
+// Serialization Tests
+// ============================================================================
+
+TEST(msgpack_between_vms) {
+    ASSERT(ph::exec("from datetime import datetime\n"
+                    "msg = {'op': 'move', 'to': [3, -4], 'at': datetime(2024, 3, 10, 12, 30)}"));
+    std::string wire;
+    bool packed = ph::msgpack_pack_to(ph::get_global("msg"), [&](const void* data, int size) {
+        wire.append(static_cast<const char*>(data), size);
+    });
+    ASSERT(packed);
+
+    int index = ph::vm_create();
+    ASSERT(index > 0);
+    py_switchvm(index);
+    bool ok = ph::msgpack_unpack(wire);
+    if (ok) {
+        ph::set_global("msg", py_retval());
+        auto check = ph::eval("msg['to'] == [3, -4] and msg['at'].isoformat()");
+        ok = check.ok() && strcmp(py_tostr(check.value()), "2024-03-10T12:30:00") == 0;
+    }
+    py_switchvm(0);
+    ph::vm_destroy(index);
+    ASSERT(ok);
+
+    // A sink returning false aborts packing
+    packed = ph::msgpack_pack_to(ph::get_global("msg"),
+                                 [](const void*, int) { return false; },
+                                 ph::ExcPolicy::Silent);
+    ASSERT(!packed);
+}
+#endif
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -421,6 +637,10 @@ int main(void) {
 
     printf("\nBinding tests:\n");
     RUN_TEST(binding_def);
+    RUN_TEST(binding_def_fast);
+    RUN_TEST(binding_module_def_table);
+    RUN_TEST(binding_lazy_module);
+    RUN_TEST(binding_import_cache_disabled);
     RUN_TEST(binding_set_get_global);
 
     printf("\nArgument extraction tests:\n");
@@ -431,6 +651,12 @@ int main(void) {
     RUN_TEST(list_foreach);
     RUN_TEST(list_from_ints);
     RUN_TEST(list_from_container);
+    RUN_TEST(list_sort_by);
+    RUN_TEST(set_from_container);
+
+    printf("\nDate and time tests:\n");
+    RUN_TEST(datetime_chrono_roundtrip);
+    RUN_TEST(datetime_arg_extraction);
 
     printf("\nResult tests:\n");
     RUN_TEST(result_success);
@@ -440,6 +666,15 @@ int main(void) {
     RUN_TEST(type_name);
     RUN_TEST(repr);
 
+    printf("\nVM management tests:\n");
+    RUN_TEST(vm_memory_limit);
+    RUN_TEST(vm_create);
+
+#ifdef PK_BUILD_MODULE_MSGPACK
+    printf("\nSerialization tests:\n");
+    RUN_TEST(msgpack_between_vms);
+#endif
+
     printf("\n========================================\n");
     printf("Results: %d passed, %d failed\n", tests_passed, tests_failed);
 
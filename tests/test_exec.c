@@ -141,6 +141,22 @@ TEST(eval_raise_success) {
     ASSERT_EQ(py_toint(py_retval()), 100);
 }
 
+TEST(match_is_a_soft_keyword) {
+    // `match` still starts a match statement, but also works as a name
+    bool ok = ph_exec(
+        "class Pattern:\n"
+        "    def match(self, s): return s == 'x'\n"
+        "match = Pattern().match('x')\n"
+        "value = 2\n"
+        "match value:\n"
+        "    case 2: kind = 'two'\n"
+        "    case _: kind = 'other'\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(py_tobool(ph_getglobal("match")));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("kind"), ""), "two");
+}
+
 TEST_SUITE_BEGIN("Execution Helpers")
     RUN_TEST(exec_simple);
     RUN_TEST(exec_multiline);
@@ -156,4 +172,5 @@ TEST_SUITE_BEGIN("Execution Helpers")
     RUN_TEST(exec_raise_success);
     RUN_TEST(eval_raise_keeps_exception);
     RUN_TEST(eval_raise_success);
+    RUN_TEST(match_is_a_soft_keyword);
 TEST_SUITE_END()
@@ -220,6 +220,27 @@ TEST(extraction_chain) {
     ph_scope_end(&scope);
 }
 
+TEST(as_datetime_ns) {
+    // 2024-03-10 12:30:45.5 as nanoseconds since 1970-01-01
+    py_i64 ns = 1710073845500000000LL;
+    ph_setglobal("t", ph_datetime_r(0, ns));
+    ph_setglobal("step", ph_timedelta_r(1, 1500000000LL));
+    ASSERT(ph_exec(
+        "import datetime\n"
+        "later = t + step\n"
+        "iso = later.isoformat()\n"
+        "parsed = datetime.datetime.fromisoformat('2024-03-10T12:30:47Z')\n"
+        "gap = parsed - t\n",
+        "<test>"
+    ));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("iso"), ""), "2024-03-10T12:30:47");
+    ASSERT_EQ(ph_as_datetime_ns(ph_getglobal("parsed"), -1), ns + 1500000000LL);
+    ASSERT_EQ(ph_as_timedelta_ns(ph_getglobal("gap"), -1), 1500000000LL);
+    // wrong types return the default
+    ASSERT_EQ(ph_as_datetime_ns(ph_getglobal("gap"), -1), -1);
+    ASSERT_EQ(ph_as_timedelta_ns(ph_tmp_int(5), -1), -1);
+}
+
 TEST_SUITE_BEGIN("Value Extraction")
     RUN_TEST(as_int_valid);
     RUN_TEST(as_int_default);
@@ -242,4 +263,5 @@ TEST_SUITE_BEGIN("Value Extraction")
     RUN_TEST(is_none);
     RUN_TEST(is_nil);
     RUN_TEST(extraction_chain);
+    RUN_TEST(as_datetime_ns);
 TEST_SUITE_END()
@@ -5,6 +5,7 @@
  * - Mixing ph_* with py_* functions
  * - Using scopes with raw py_exec
  * - Combining high-level value creation with low-level operations
+ * - Passing msgpack messages through a native writer
  */
 
 #include "test_common.h"
@@ -243,6 +244,197 @@ TEST(module_interop) {
     ASSERT_EQ(py_toint(py_retval()), 42);
 }
 
+TEST(struct_unpacks_host_packet) {
+    // Host hands over a little-endian packet: u16 id, i32 value, f32 x3
+    unsigned char packet[22] = {0x34, 0x12, 0xfe, 0xff, 0xff, 0xff};
+    float coords[3] = {1.5f, -2.0f, 0.25f};
+    memcpy(packet + 6, coords, sizeof(coords));
+    memcpy(packet + 18, "\x01\x00\x02\x00", 4);
+    unsigned char* p = py_newbytes(py_r0(), sizeof(packet));
+    memcpy(p, packet, sizeof(packet));
+    py_setglobal(py_name("packet"), py_r0());
+
+    bool ok = ph_exec(
+        "import struct\n"
+        "header = struct.Struct('<Hi3f')\n"
+        "ident, value, x, y, z = header.unpack_from(packet)\n"
+        "tail = [t[0] for t in struct.iter_unpack('<H', packet[header.size:])]\n"
+        "wire = header.pack(ident, value, x, y, z)\n"
+        "be = struct.pack('>I', 1)\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(ph_getglobal("ident")), 0x1234);
+    ASSERT_EQ(py_toint(ph_getglobal("value")), -2);
+    ASSERT(py_tofloat(ph_getglobal("y")) == -2.0);
+    ASSERT(ph_eval("tail == [1, 2] and wire == packet[:18]"));
+    ASSERT(py_tobool(py_retval()));
+
+    int size;
+    unsigned char* be = py_tobytes(ph_getglobal("be"), &size);
+    ASSERT_EQ(size, 4);
+    ASSERT(be[0] == 0 && be[3] == 1);
+}
+
+TEST(struct_rejects_bad_input) {
+    bool ok = ph_exec(
+        "import struct\n"
+        "errors = []\n"
+        "for f in [lambda: struct.unpack('<I', bytes([1, 2])),\n"
+        "          lambda: struct.pack('B', 256),\n"
+        "          lambda: struct.calcsize('3z'),\n"
+        "          lambda: struct.Struct('<h').unpack_from(bytes([0, 0]), 1)]:\n"
+        "    try:\n"
+        "        f()\n"
+        "        errors.append(None)\n"
+        "    except struct.error:\n"
+        "        errors.append('error')\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("errors == ['error'] * 4"));
+    ASSERT(py_tobool(py_retval()));
+
+    // struct.error is ValueError; a non-bytes buffer is a TypeError
+    ASSERT(!ph_exec_raise("import struct\nstruct.pack('<I', 'x')", "<test>"));
+    ASSERT(py_matchexc(tp_ValueError));
+    py_clearexc(NULL);
+    ASSERT(!ph_exec_raise("import struct\nstruct.unpack('<I', [1, 2, 3, 4])", "<test>"));
+    ASSERT(py_matchexc(tp_TypeError));
+    py_clearexc(NULL);
+}
+
+TEST(re_tokenizes_script_input) {
+    py_newstr(py_r0(), "let total = price * 3 + tax;  # café");
+    py_setglobal(py_name("line"), py_r0());
+    bool ok = ph_exec(
+        "import re\n"
+        "token = re.compile(r'(?P<num>\\d+)|(?P<name>\\w+)|(?P<op>[=*+;])|(?P<ws>\\s+)|#.*')\n"
+        "kinds = [m.lastgroup for m in token.finditer(line) if m.lastgroup not in ('ws', None)]\n"
+        "names = re.findall(r'[a-z]+', line)\n"
+        "doubled = re.sub(r'\\d+', lambda m: str(int(m.group()) * 2), line)\n"
+        "fields = re.split(r'\\s*([=*+])\\s*', 'a = b*c')\n"
+        "m = re.search(r'caf(.)', line)\n"
+        "span = m.span(1)\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("kinds == ['name', 'name', 'op', 'name', 'op', 'num', 'op', 'name', 'op']"));
+    ASSERT(py_tobool(py_retval()));
+    ASSERT(ph_eval("names == ['let', 'total', 'price', 'tax', 'caf']"));
+    ASSERT(py_tobool(py_retval()));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("doubled"), ""), "let total = price * 6 + tax;  # café");
+    ASSERT(ph_eval("fields == ['a', '=', 'b', '*', 'c']"));
+    ASSERT(py_tobool(py_retval()));
+    // Positions count code points, not UTF-8 bytes
+    ASSERT(ph_eval("span == (35, 36)"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(re_compile_errors_and_cache) {
+    bool ok = ph_exec(
+        "import re\n"
+        "same = re.compile('a+b', re.I) is re.compile('a+b', re.I)\n"
+        "errors = []\n"
+        "for p in ['(a', 'a**', '[a-', '\\\\q', '(?<=a)b']:\n"
+        "    try:\n"
+        "        re.compile(p)\n"
+        "        errors.append(None)\n"
+        "    except re.error:\n"
+        "        errors.append(p)\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(py_tobool(ph_getglobal("same")));
+    ASSERT(ph_eval("None not in errors"));
+    ASSERT(py_tobool(py_retval()));
+
+    // An exception from a replacement function propagates
+    ASSERT(!ph_exec_raise("import re\nre.sub('a', lambda m: 1 / 0, 'abc')", "<test>"));
+    ASSERT(py_matchexc(tp_ZeroDivisionError));
+    py_clearexc(NULL);
+}
+
+#ifdef PK_BUILD_MODULE_MSGPACK
+typedef struct {
+    unsigned char data[8192];
+    int size;
+    int calls;
+} msg_buffer;
+
+static bool msg_buffer_write(void* ctx, const void* data, int size) {
+    msg_buffer* buf = (msg_buffer*)ctx;
+    if (buf->size + size > (int)sizeof(buf->data)) return false;
+    memcpy(buf->data + buf->size, data, size);
+    buf->size += size;
+    buf->calls++;
+    return true;
+}
+
+TEST(msgpack_roundtrip_through_writer) {
+    // Host packs into its own buffer, script VM unpacks
+    ASSERT(ph_exec("msg = {'id': 7, 'neg': -40000, 'ok': True, 'x': 0.5,\n"
+                   "       'tags': ['a', None, (1, 2)], 'blob': ('x' * 2000).encode()}",
+                   "<test>"));
+    py_ItemRef msg = py_getglobal(py_name("msg"));
+
+    static msg_buffer buf;
+    buf.size = 0;
+    buf.calls = 0;
+    ph_Writer writer = {msg_buffer_write, &buf};
+    ASSERT(ph_msgpack_pack_to(msg, writer));
+    // The 2000-byte payload went to the writer on its own
+    ASSERT(buf.calls >= 2);
+
+    ASSERT(ph_msgpack_unpack(buf.data, buf.size));
+    py_setglobal(py_name("back"), py_retval());
+    ASSERT(ph_eval("back == {'id': 7, 'neg': -40000, 'ok': True, 'x': 0.5,"
+                   " 'tags': ['a', None, [1, 2]], 'blob': ('x' * 2000).encode()}"));
+    ASSERT(py_tobool(py_retval()));
+
+    // Same bytes as msgpack.packb
+    ASSERT(ph_exec("import msgpack\nb = msgpack.packb({'a': 1})", "<test>"));
+    int size;
+    unsigned char* p = py_tobytes(py_getglobal(py_name("b")), &size);
+    ASSERT_EQ(size, 4);
+    ASSERT(p[0] == 0x81 && p[1] == 0xa1 && p[2] == 'a' && p[3] == 0x01);
+}
+
+TEST(msgpack_errors_propagate) {
+    // Truncated input
+    const unsigned char truncated[] = {0x92, 0x01};
+    ASSERT(!ph_msgpack_unpack_raise(truncated, sizeof(truncated)));
+    ASSERT(py_matchexc(tp_ValueError));
+    py_clearexc(NULL);
+
+    // Malformed UTF-8 in fixstr, str8 and a map key; a cut-off sequence and a surrogate
+    const char* bad_strs[] = {
+        "b'\\xa2\\xff\\xfe'",
+        "b'\\xd9\\x02\\xc3\\x28'",
+        "b'\\x81\\xa1\\x80\\x01'",
+        "b'\\xa2a\\xc3'",
+        "b'\\xa3\\xed\\xa0\\x80'",
+    };
+    ASSERT(ph_exec("import msgpack", "<test>"));
+    for(int i = 0; i < 5; i++) {
+        char src[64];
+        snprintf(src, sizeof(src), "msgpack.unpackb(%s)", bad_strs[i]);
+        ASSERT(!ph_eval_raise(src));
+        ASSERT(py_matchexc(tp_ValueError));
+        py_clearexc(NULL);
+    }
+    ASSERT(ph_exec("u = msgpack.unpackb(msgpack.packb('h\xc3\xa9\xe4\xb8\x96\xf0\x9f\x98\x80'))",
+                   "<test>"));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("u"), ""), "h\xc3\xa9\xe4\xb8\x96\xf0\x9f\x98\x80");
+
+    // Unsupported type
+    ASSERT(ph_eval("[1, object()]"));
+    py_assign(py_r4(), py_retval());
+    static msg_buffer buf;
+    buf.size = 0;
+    ph_Writer writer = {msg_buffer_write, &buf};
+    ASSERT(!ph_msgpack_pack_to_raise(py_r4(), writer));
+    ASSERT(py_matchexc(tp_TypeError));
+    py_clearexc(NULL);
+}
+#endif
+
 TEST_SUITE_BEGIN("API Interoperability")
     RUN_TEST(mix_exec_styles);
     RUN_TEST(mix_value_creation);
@@ -254,4 +446,12 @@ TEST_SUITE_BEGIN("API Interoperability")
     RUN_TEST(error_handling_interop);
     RUN_TEST(register_reuse);
     RUN_TEST(module_interop);
+    RUN_TEST(struct_unpacks_host_packet);
+    RUN_TEST(struct_rejects_bad_input);
+    RUN_TEST(re_tokenizes_script_input);
+    RUN_TEST(re_compile_errors_and_cache);
+#ifdef PK_BUILD_MODULE_MSGPACK
+    RUN_TEST(msgpack_roundtrip_through_writer);
+    RUN_TEST(msgpack_errors_propagate);
+#endif
 TEST_SUITE_END()
@@ -5,6 +5,8 @@
  * - Building lists from C arrays
  * - Iterating lists with callbacks
  * - List manipulation patterns
+ * - Sorting by a key computed once per element (list.sort, ph_list_sort_by)
+ * - Building native sets from C arrays (ph_set_from_*)
  */
 
 #include "test_common.h"
@@ -199,6 +201,417 @@ TEST(list_mixed_creation) {
     ASSERT(py_isbool(py_list_getitem(py_r0(), 3)));
 }
 
+/* ============================================================================
+ * Sorting
+ * ============================================================================ */
+
+TEST(list_sort_key_called_once) {
+    bool ok = ph_exec(
+        "calls = 0\n"
+        "def neg(x):\n"
+        "    global calls\n"
+        "    calls += 1\n"
+        "    return -x\n"
+        "data = [5, 3, 9, 1, 7] * 20\n"
+        "data.sort(key=neg)\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(ph_getglobal("calls")), 100);
+    ASSERT(ph_eval("data == [9] * 20 + [7] * 20 + [5] * 20 + [3] * 20 + [1] * 20"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(list_sort_reverse_is_stable) {
+    bool ok = ph_exec(
+        "rows = [(1, 'a'), (0, 'b'), (1, 'c'), (0, 'd'), (2, 'e')]\n"
+        "by_key = sorted(rows, key=lambda r: r[0], reverse=True)\n"
+        "rows.sort(key=lambda r: r[0])\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("by_key == [(2, 'e'), (1, 'a'), (1, 'c'), (0, 'b'), (0, 'd')]"));
+    ASSERT(py_tobool(py_retval()));
+    ASSERT(ph_eval("rows == [(0, 'b'), (0, 'd'), (1, 'a'), (1, 'c'), (2, 'e')]"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(list_sort_key_error_keeps_list) {
+    bool ok = ph_exec(
+        "data = [3, 'x', 1]\n"
+        "try:\n"
+        "    data.sort(key=lambda v: v + 1)\n"
+        "    failed = False\n"
+        "except TypeError:\n"
+        "    failed = True\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(py_tobool(ph_getglobal("failed")));
+    ASSERT(ph_eval("data == [3, 'x', 1]"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(list_sort_runs_and_native_types) {
+    bool ok = ph_exec(
+        "import random\n"
+        "random.seed(7)\n"
+        "def check(data):\n"
+        "    expect = data[:]\n"
+        "    for i in range(1, len(expect)):\n"
+        "        j = i\n"
+        "        while j > 0 and expect[j] < expect[j - 1]:\n"
+        "            expect[j], expect[j - 1] = expect[j - 1], expect[j]\n"
+        "            j -= 1\n"
+        "    data.sort()\n"
+        "    return data == expect\n"
+        "nearly = list(range(600))\n"
+        "for _ in range(10):\n"
+        "    i = random.randint(0, 599)\n"
+        "    nearly[i] = random.randint(0, 599)\n"
+        "results = [\n"
+        "    check(nearly),\n"
+        "    check(list(range(500, 0, -1))),\n"
+        "    check(list(range(300)) + list(range(300))),\n"
+        "    check([random.randint(0, 50) for _ in range(700)]),\n"
+        "    check([random.random() for _ in range(300)]),\n"
+        "    check([str(random.randint(0, 999)) for _ in range(300)]),\n"
+        "    check([1, 2.5, 0, -1.5, 3] * 40),\n"
+        "]\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("results == [True] * 7"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(list_sort_short_lists) {
+    bool ok = ph_exec(
+        "class A:\n"
+        "    def __lt__(self, other): return False\n"
+        "empty = []\n"
+        "empty.sort()\n"
+        "one = [A()]\n"
+        "one.sort(reverse=True)\n"
+        "results = [empty == [], len(one) == 1, sorted([]) == [], sorted([A()])[0] is not None]\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("results == [True] * 4"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(list_sort_stable_across_runs) {
+    bool ok = ph_exec(
+        "pairs = [(i % 7, i) for i in range(1000)]\n"
+        "pairs.sort(key=lambda p: p[0])\n"
+        "stable = all([pairs[i][0] < pairs[i + 1][0] or pairs[i][1] < pairs[i + 1][1]\n"
+        "              for i in range(len(pairs) - 1)])\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(py_tobool(ph_getglobal("stable")));
+}
+
+TEST(list_sort_compare_error_keeps_elements) {
+    bool ok = ph_exec(
+        "data = list(range(200, 0, -1)) + ['x'] + list(range(200))\n"
+        "try:\n"
+        "    data.sort()\n"
+        "    failed = False\n"
+        "except TypeError:\n"
+        "    failed = True\n"
+        "rest = [v for v in data if v != 'x']\n"
+        "rest.sort()\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(py_tobool(ph_getglobal("failed")));
+    ASSERT(ph_eval("len(data) == 401 and rest == sorted(list(range(1, 201)) + list(range(200)))"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(list_sort_key_compare_clears_list) {
+    // the values are only referenced by the list that __lt__ empties
+    bool ok = ph_exec(
+        "import gc\n"
+        "class K:\n"
+        "    def __init__(self, n): self.n = n\n"
+        "    def __lt__(self, other):\n"
+        "        for i in range(len(data)): data[i] = None\n"
+        "        gc.collect()\n"
+        "        return self.n < other.n\n"
+        "data = [[i] * 50 for i in range(20, 0, -1)]\n"
+        "data.sort(key=lambda v: K(v[0]))\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("data == [[i] * 50 for i in range(1, 21)]"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+// Sort key: second field of a (name, score) tuple
+static bool score_key(py_Ref item, py_OutRef out, void* ctx) {
+    (void)ctx;
+    if (!py_checktype(item, tp_tuple)) return false;
+    py_assign(out, py_tuple_getitem(item, 1));
+    return true;
+}
+
+TEST(list_sort_by_native_key) {
+    ASSERT(ph_exec("records = [('c', 30), ('a', 10), ('d', 30), ('b', 20)]", "<test>"));
+    py_ItemRef records = ph_getglobal("records");
+
+    ASSERT(ph_list_sort_by(records, score_key, NULL, false));
+    ASSERT(ph_eval("[r[0] for r in records] == ['a', 'b', 'c', 'd']"));
+    ASSERT(py_tobool(py_retval()));
+
+    ASSERT(ph_list_sort_by(records, score_key, NULL, true));
+    ASSERT(ph_eval("[r[0] for r in records] == ['c', 'd', 'b', 'a']"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(list_sort_by_key_error) {
+    ASSERT(ph_exec("mixed = [('a', 1), 2]", "<test>"));
+    ASSERT(!ph_list_sort_by_raise(ph_getglobal("mixed"), score_key, NULL, false));
+    ASSERT(py_matchexc(tp_TypeError));
+    py_clearexc(NULL);
+    ASSERT(ph_eval("mixed == [('a', 1), 2]"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(set_from_ints) {
+    py_i64 values[] = {5, 3, 5, 1, 3};
+    ph_set_from_ints(py_r0(), values, 5);
+
+    ASSERT(py_isset(py_r0()));
+    ASSERT_EQ(py_set_len(py_r0()), 3);
+
+    py_TValue key;
+    py_newint(&key, 3);
+    ASSERT_EQ(py_set_contains(py_r0(), &key), 1);
+    py_newint(&key, 4);
+    ASSERT_EQ(py_set_contains(py_r0(), &key), 0);
+}
+
+TEST(set_from_strs_membership) {
+    const char* values[] = {"GET", "HEAD", "OPTIONS"};
+    ph_set_from_strs(py_r0(), values, 3);
+    ph_setglobal("safe", py_r0());
+
+    ASSERT(ph_eval("'HEAD' in safe and 'POST' not in safe"));
+    ASSERT(py_tobool(py_retval()));
+    ASSERT(ph_eval("sorted(safe | {'POST'}) == ['GET', 'HEAD', 'OPTIONS', 'POST']"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(set_algebra) {
+    bool ok = ph_exec(
+        "a = {1, 2, 3, 4}\n"
+        "b = set([3, 4, 5])\n"
+        "results = [\n"
+        "    a | b == {1, 2, 3, 4, 5},\n"
+        "    a & b == {3, 4},\n"
+        "    a - b == {1, 2},\n"
+        "    a ^ b == {1, 2, 5},\n"
+        "    a.intersection([4, 9], (4, 3)) == {4},\n"
+        "    {1, 2} < a and a >= {1} and a.isdisjoint([7]),\n"
+        "    {i % 5 for i in range(100)} == set(range(5)),\n"
+        "    repr(set()) == 'set()' and repr({7}) == '{7}',\n"
+        "]\n"
+        "a.difference_update([1, 2])\n"
+        "a.discard(3)\n"
+        "results.append(a == {4})\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("results == [True] * 9"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(frozenset_is_hashable) {
+    bool ok = ph_exec(
+        "rules = {frozenset(['a', 'b']): 1, frozenset(['c']): 2}\n"
+        "hit = rules[frozenset(['b', 'a'])]\n"
+        "try:\n"
+        "    hash({1})\n"
+        "    unhashable = False\n"
+        "except TypeError:\n"
+        "    unhashable = True\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(ph_getglobal("hit")), 1);
+    ASSERT(py_tobool(ph_getglobal("unhashable")));
+}
+
+TEST(set_modified_during_iteration) {
+    bool ok = ph_exec(
+        "s = {1, 2, 3}\n"
+        "try:\n"
+        "    for v in s:\n"
+        "        s.add(v + 10)\n"
+        "    raised = False\n"
+        "except RuntimeError:\n"
+        "    raised = True\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(py_tobool(ph_getglobal("raised")));
+}
+
+TEST(set_subclass) {
+    bool ok = ph_exec(
+        "import gc\n"
+        "class Tags(set):\n"
+        "    def __init__(self, items, owner):\n"
+        "        super().__init__(items)\n"
+        "        self.owner = owner\n"
+        "class Key(frozenset):\n"
+        "    pass\n"
+        "t = Tags([str(i) for i in range(100)], 'me')\n"
+        "gc.collect()\n"
+        "t.add('x')\n"
+        "k = Key([1, 2])\n"
+        "results = [\n"
+        "    len(t) == 101 and '42' in t and t.owner == 'me',\n"
+        "    isinstance(t, set) and type(t | {'y'}) is set,\n"
+        "    t >= {'1', '2'} and {'1'} < t,\n"
+        "    {k: 1}[frozenset([2, 1])] == 1 and type(k & {1}) is frozenset,\n"
+        "    repr(Key()) == 'Key()' and repr(Key([3])) == 'Key({3})',\n"
+        "    type(Key(k)) is Key and type(frozenset(k)) is frozenset,\n"
+        "]\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("results == [True] * 6"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(deque_ring_buffer) {
+    bool ok = ph_exec(
+        "from collections import deque\n"
+        "d = deque([2, 3])\n"
+        "for i in range(20):\n"
+        "    d.append(i)\n"
+        "    d.appendleft(-i)\n"
+        "    d.popleft()\n"
+        "d.rotate(3)\n"
+        "d.extendleft([100, 101])\n"
+        "results = [\n"
+        "    d.popleft() == 101 and d.pop() == 16,\n"
+        "    list(d)[:5] == [100, 17, 18, 19, 2],\n"
+        "    len(d) == 22 and 3 in d and d.count(2) == 2,\n"
+        "    d == d.copy() and d != deque(),\n"
+        "    repr(deque([1, 'a'])) == \"deque([1, 'a'])\",\n"
+        "]\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("results == [True] * 5"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(deque_maxlen_drops_opposite_end) {
+    bool ok = ph_exec(
+        "from collections import deque\n"
+        "recent = deque(range(10), maxlen=3)\n"
+        "recent.appendleft(-1)\n"
+        "r = repr(recent)\n"
+        "try:\n"
+        "    deque().pop()\n"
+        "    raised = False\n"
+        "except IndexError:\n"
+        "    raised = True\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("r"), ""), "deque([-1, 7, 8], maxlen=3)");
+    ASSERT(py_tobool(ph_getglobal("raised")));
+}
+
+TEST(deque_subclass) {
+    bool ok = ph_exec(
+        "import gc\n"
+        "from collections import deque\n"
+        "class History(deque):\n"
+        "    def __init__(self, name, size):\n"
+        "        super().__init__([], size)\n"
+        "        self.name = name\n"
+        "h = History('log', 50)\n"
+        "for i in range(100):\n"
+        "    h.append(str(i))\n"
+        "gc.collect()\n"
+        "results = [\n"
+        "    len(h) == 50 and isinstance(h, deque) and h.maxlen == 50,\n"
+        "    h.popleft() == '50' and h.pop() == '99' and h.name == 'log',\n"
+        "    h == deque([str(i) for i in range(51, 99)]),\n"
+        "    type(h.copy()) is deque,\n"
+        "    repr(History('x', 2)) == 'History([], maxlen=2)',\n"
+        "]\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("results == [True] * 5"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(heapq_pops_in_order) {
+    bool ok = ph_exec(
+        "import heapq\n"
+        "ints = [5, 1, 4, 1, 9, 2, 6]\n"
+        "heapq.heapify(ints)\n"
+        "tasks = []\n"
+        "for t in [(2, 'b'), (1, 'a'), (3, 'c')]:\n"
+        "    heapq.heappush(tasks, t)\n"
+        "order = [heapq.heappop(ints) for _ in range(7)]\n"
+        "first = heapq.heappop(tasks)[1]\n"
+        "kept = heapq.heappushpop([1.5, 2.5], 0.5)\n"
+        "replaced = heapq.heapreplace(tasks, (0, 'z'))[1]\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("order == [1, 1, 2, 4, 5, 6, 9]"));
+    ASSERT(py_tobool(py_retval()));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("first"), ""), "a");
+    ASSERT(py_tofloat(ph_getglobal("kept")) == 0.5);
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("replaced"), ""), "b");
+}
+
+TEST(heapq_compare_error_keeps_items) {
+    // same contents as cpython's heapq leaves behind
+    bool ok = ph_exec(
+        "import heapq\n"
+        "class V:\n"
+        "    def __init__(self, n): self.n = n\n"
+        "    def __lt__(self, other):\n"
+        "        if self.n == 99 or other.n == 99: raise ValueError\n"
+        "        return self.n < other.n\n"
+        "def attempt(f, *args):\n"
+        "    try:\n"
+        "        f(*args)\n"
+        "    except ValueError:\n"
+        "        pass\n"
+        "pushed = [V(n) for n in [0, 99, 2, 3, 4, 5, 6]]\n"
+        "attempt(heapq.heappush, pushed, V(-1))\n"
+        "popped = [V(n) for n in [0, 1, 2, 3, 5, 6, 99]]\n"
+        "attempt(heapq.heappop, popped)\n"
+        "pushed = [v.n for v in pushed]\n"
+        "popped = [v.n for v in popped]\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT(ph_eval("pushed == [0, 99, 2, -1, 4, 5, 6, 3] and popped == [1, 3, 2, 99, 5, 6]"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(bisect_and_insort) {
+    bool ok = ph_exec(
+        "import bisect\n"
+        "a = [1, 2, 2, 2, 5]\n"
+        "left = bisect.bisect_left(a, 2)\n"
+        "right = bisect.bisect(a, 2)\n"
+        "bounded = bisect.bisect_right(a, 5, 0, 3)\n"
+        "bisect.insort(a, 3)\n"
+        "bisect.insort_left(a, 0)\n"
+        "try:\n"
+        "    bisect.bisect_left(a, 1, -1)\n"
+        "    raised = False\n"
+        "except ValueError:\n"
+        "    raised = True\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(ph_getglobal("left")), 1);
+    ASSERT_EQ(py_toint(ph_getglobal("right")), 4);
+    ASSERT_EQ(py_toint(ph_getglobal("bounded")), 3);
+    ASSERT(ph_eval("a == [0, 1, 2, 2, 2, 3, 5]"));
+    ASSERT(py_tobool(py_retval()));
+    ASSERT(py_tobool(ph_getglobal("raised")));
+}
+
 TEST_SUITE_BEGIN("List Helpers")
     RUN_TEST(list_from_ints);
     RUN_TEST(list_from_ints_empty);
@@ -212,4 +625,26 @@ TEST_SUITE_BEGIN("List Helpers")
     RUN_TEST(list_foreach_empty);
     RUN_TEST(list_in_python);
     RUN_TEST(list_mixed_creation);
+    RUN_TEST(list_sort_key_called_once);
+    RUN_TEST(list_sort_reverse_is_stable);
+    RUN_TEST(list_sort_key_error_keeps_list);
+    RUN_TEST(list_sort_runs_and_native_types);
+    RUN_TEST(list_sort_short_lists);
+    RUN_TEST(list_sort_stable_across_runs);
+    RUN_TEST(list_sort_compare_error_keeps_elements);
+    RUN_TEST(list_sort_key_compare_clears_list);
+    RUN_TEST(list_sort_by_native_key);
+    RUN_TEST(list_sort_by_key_error);
+    RUN_TEST(set_from_ints);
+    RUN_TEST(set_from_strs_membership);
+    RUN_TEST(set_algebra);
+    RUN_TEST(frozenset_is_hashable);
+    RUN_TEST(set_modified_during_iteration);
+    RUN_TEST(set_subclass);
+    RUN_TEST(deque_ring_buffer);
+    RUN_TEST(deque_maxlen_drops_opposite_end);
+    RUN_TEST(deque_subclass);
+    RUN_TEST(heapq_pops_in_order);
+    RUN_TEST(heapq_compare_error_keeps_items);
+    RUN_TEST(bisect_and_insort);
 TEST_SUITE_END()
@@ -101,6 +101,84 @@ TEST(setglobal_with_value) {
     ASSERT_STR_EQ(py_tostr(py_retval()), "TEST STRING");
 }
 
+TEST(long_str_length_and_indexing) {
+    // 16 bytes or more are heap strings that cache their length and hash
+    py_newstr(py_r0(), "naïve café, déjà vu");
+    py_setglobal(py_name("s"), py_r0());
+    ASSERT(ph_eval("len(s)"));
+    ASSERT_EQ(py_toint(py_retval()), 19);
+    ASSERT(ph_eval("s[2] + s[-1] + s[-9:-7] + s[::6]"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "ïu, ncdu");
+
+    py_newstr(py_r0(), "ascii only text for slicing");
+    py_setglobal(py_name("t"), py_r0());
+    ASSERT(ph_eval("t[-4] + t[6:10] + t[::-9] + t[100:]"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "conlygol");
+    ASSERT(ph_eval("{t: 1}[t[:5] + t[5:]] == 1 and hash(t) == hash(t[:])"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(str_hash_is_wyhash) {
+    // wyhash with the default seed 0; the first is wyhash's own test vector
+    ASSERT(ph_eval("hash('')"));
+    ASSERT_EQ((uint64_t)py_toint(py_retval()), 0x93228a4de0eec5a2ull);
+    ASSERT(ph_eval("hash('https://example.com/api/v1/users/42')"));
+    ASSERT_EQ((uint64_t)py_toint(py_retval()), 0xc80465741a136817ull);
+
+    bool ok = ph_exec(
+        "urls = {}\n"
+        "for i in range(2000): urls[f'https://example.com/api/v1/users/{i}/posts'] = i\n"
+        "for i in range(0, 2000, 2): del urls[f'https://example.com/api/v1/users/{i}/posts']\n"
+        "found = sum([urls.get(f'https://example.com/api/v1/users/{i}/posts', 0) for i in range(2000)])\n",
+        "<test>");
+    ASSERT(ok);
+    ASSERT_EQ(py_toint(ph_getglobal("found")), 1000000);
+}
+
+TEST(str_search_and_replace) {
+    py_newstr(py_r0(), "café au lait, café noir, thé");
+    py_setglobal(py_name("s"), py_r0());
+    // find() positions count code points
+    ASSERT(ph_eval("[s.find('café'), s.find('café', 1), s.find('thé', -3), s.find('x'), s.count('é')] "
+                   "== [0, 14, 25, -1, 3]"));
+    ASSERT(py_tobool(py_retval()));
+    ASSERT(ph_eval("s.replace('café', 'tea')"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "tea au lait, tea noir, thé");
+    ASSERT(ph_eval("'hé'.replace('', '-') + 'a\\x00b'.replace('\\x00', '0')"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "-h-é-a0b");
+    ASSERT(ph_eval("s.split(', ') == ['café au lait', 'café noir', 'thé'] and 'noir' in s"));
+    ASSERT(py_tobool(py_retval()));
+}
+
+TEST(str_join_and_fstring) {
+    ASSERT(ph_eval("', '.join(['naïve', '', 'x' * 20]) + '|' + '-'.join(('a',)) + '-'.join([])"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "naïve, , xxxxxxxxxxxxxxxxxxxx|a");
+    ASSERT(ph_eval("'/'.join(map(str, range(4))) + f' {1.5} {None} {[1]!r:>5}'"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "0/1/2/3 1.5 None   [1]");
+
+    ASSERT(!ph_exec_raise("','.join(['a', 1])", "<test>"));
+    ASSERT(py_matchexc(tp_TypeError));
+    py_clearexc(NULL);
+}
+
+TEST(float_repr_round_trips) {
+    // shortest digits that read back as the same double, in CPython's layout
+    ASSERT(ph_eval("' '.join([repr(0.1 + 0.2), repr(1 / 3), str(2.0), str(-0.0), repr(1e16), "
+                   "repr(1e-05), repr(0.0001), repr(5e-324), repr(1.7976931348623157e308), "
+                   "repr(123456789.125), repr(-1.5e-300)])"));
+    ASSERT_STR_EQ(py_tostr(py_retval()),
+                  "0.30000000000000004 0.3333333333333333 2.0 -0.0 1e+16 1e-05 0.0001 "
+                  "5e-324 1.7976931348623157e+308 123456789.125 -1.5e-300");
+    ASSERT(ph_eval("all([float(repr(x)) == x for x in [i / 7 + 0.1 for i in range(1000)]])"));
+    ASSERT(py_tobool(py_retval()));
+
+    ASSERT(ph_eval("str(-9223372036854775807 - 1) + ' ' + str(1099511627776) + ' ' + f'{2.5:.3f}'"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "-9223372036854775808 1099511627776 2.500");
+    ASSERT(ph_exec("import json", "<test>"));
+    ASSERT(ph_eval("json.dumps([0.1, 1e22, 2**40, -7])"));
+    ASSERT_STR_EQ(py_tostr(py_retval()), "[0.1, 1e+22, 1099511627776, -7]");
+}
+
 TEST(overwrite_register) {
     // Creating a new value in r0 overwrites previous
     ph_tmp_int(100);
@@ -126,4 +204,9 @@ TEST_SUITE_BEGIN("Value Creation")
     RUN_TEST(create_float_with_register);
     RUN_TEST(setglobal_with_value);
     RUN_TEST(overwrite_register);
+    RUN_TEST(long_str_length_and_indexing);
+    RUN_TEST(str_hash_is_wyhash);
+    RUN_TEST(str_search_and_replace);
+    RUN_TEST(str_join_and_fstring);
+    RUN_TEST(float_repr_round_trips);
 TEST_SUITE_END()
@@ -0,0 +1,460 @@
+/*
+ * test_vm.c - Tests for per-VM resource controls
+ *
+ * Tests ph_vm_set_memory_limit and ph_vm_memory_stats: accounting of heap,
+ * string and buffer memory, and MemoryError once a VM exceeds its limit.
+ * Tests ph_vm_create: per-VM value stack size (including deeply nested
+ * msgpack input), recursion limit and frame pool size, and the ph_vm_stats
+ * call counters. Builtins shared between VMs must behave as if each VM had
+ * compiled them itself, and so must the stdlib bytecode produced by
+ * py_dumpcode at build time.
+ */
+
+#include "test_common.h"
+
+// Run source with py_exec, keeping the exception for inspection
+static bool exec_keep_exc(const char* source) {
+    return py_exec(source, "<test>", EXEC_MODE, NULL);
+}
+
+/* ============================================================================
+ * ph_vm_memory_stats tests
+ * ============================================================================ */
+
+TEST(memory_stats_tracks_objects) {
+    py_gc_collect();
+    ph_MemoryStats before = ph_vm_memory_stats();
+    ASSERT(before.heap_size > 0);
+    ASSERT_EQ(before.used_size, before.heap_size + before.buffer_size);
+    ASSERT_EQ(before.limit, (size_t)0);
+
+    bool ok = ph_exec("big_str = 'x' * 100000\nbig_list = list(range(10000))", "<test>");
+    ASSERT(ok);
+    py_gc_collect();
+    ph_MemoryStats after = ph_vm_memory_stats();
+    ASSERT(after.str_size >= 100000);
+    ASSERT(after.buffer_size >= before.buffer_size + 10000 * sizeof(py_TValue));
+    ASSERT(after.peak_size >= after.used_size);
+
+    py_pushnone();
+    ASSERT_EQ(ph_vm_memory_stats().stack_size, after.stack_size + sizeof(py_TValue));
+    py_pop();
+}
+
+TEST(memory_stats_reclaimed) {
+    bool ok = ph_exec("tmp = ['item ' + str(i) for i in range(20000)]", "<test>");
+    ASSERT(ok);
+    py_gc_collect();
+    size_t with_list = ph_vm_memory_stats().used_size;
+
+    ok = ph_exec("tmp = None", "<test>");
+    ASSERT(ok);
+    py_gc_collect();
+    ASSERT(ph_vm_memory_stats().used_size < with_list);
+}
+
+/* ============================================================================
+ * ph_vm_set_memory_limit tests
+ * ============================================================================ */
+
+TEST(memory_limit_bulk_allocation) {
+    py_gc_collect();
+    ph_vm_set_memory_limit(ph_vm_memory_stats().used_size + 1024 * 1024);
+
+    bool ok = exec_keep_exc("x = [0] * 1000000");
+    ASSERT(!ok);
+    ASSERT(py_matchexc(tp_MemoryError));
+    py_clearexc(NULL);
+
+    ok = exec_keep_exc("s = 'abc' * 1000000");
+    ASSERT(!ok);
+    ASSERT(py_matchexc(tp_MemoryError));
+    py_clearexc(NULL);
+
+    ph_vm_set_memory_limit(0);
+    ok = ph_exec("x = [0] * 1000000", "<test>");
+    ASSERT(ok);
+}
+
+TEST(memory_limit_growth_loop) {
+    py_gc_collect();
+    ph_vm_set_memory_limit(ph_vm_memory_stats().used_size + 1024 * 1024);
+
+    bool ok = exec_keep_exc(
+        "items = []\n"
+        "while True:\n"
+        "    items.append('a string that lives on the heap ' + str(len(items)))\n");
+    ASSERT(!ok);
+    ASSERT(py_matchexc(tp_MemoryError));
+    py_clearexc(NULL);
+
+    // the script can recover by dropping what it holds
+    ok = exec_keep_exc(
+        "try:\n"
+        "    d = {}\n"
+        "    while True:\n"
+        "        d[len(d)] = 'value'\n"
+        "except MemoryError:\n"
+        "    d = None\n"
+        "recovered = True\n");
+    ASSERT(ok);
+    ASSERT(py_tobool(ph_getglobal("recovered")));
+
+    ph_vm_set_memory_limit(0);
+}
+
+TEST(memory_limit_single_native_call) {
+    // a fresh VM, so peak_size only covers this test
+    int index = ph_vm_create(NULL);
+    py_switchvm(index);
+    py_gc_collect();
+    size_t limit = ph_vm_memory_stats().used_size + 1024 * 1024;
+    ph_vm_set_memory_limit(limit);
+
+    // each of these grows one container inside a single native call
+    const char* sources[] = {
+        "x = list(range(10000000))",
+        "x = set(range(10000000))",
+        "from collections import deque\nx = deque(range(10000000))",
+        "x = {i: i for i in range(10000000)}",
+    };
+    for(int i = 0; i < (int)PH_COUNTOF(sources); i++) {
+        ASSERT(!exec_keep_exc(sources[i]));
+        ASSERT(py_matchexc(tp_MemoryError));
+        py_clearexc(NULL);
+    }
+    // garbage is only collected between bytecodes, so one allocation that would fit next to
+    // the live objects may still overshoot the limit
+    ASSERT(ph_vm_memory_stats().peak_size <= limit + 1024 * 1024);
+
+    py_switchvm(0);
+    ph_vm_destroy(index);
+}
+
+TEST(memory_limit_unrooted_c_values) {
+    py_gc_collect();
+    ph_vm_set_memory_limit(ph_vm_memory_stats().used_size + 200000);
+    ASSERT(ph_exec("for i in range(100): s = 'x' * 10000", "<test>"));
+
+    // values held only in C locals must survive a reservation that hits the limit;
+    // they are larger than a pool block so a premature free is visible to ASan
+    char text[1024];
+    memset(text, 'v', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    py_Ref d = py_pushtmp();
+    py_newdict(d);
+    bool ok = true;
+    for(int i = 0; ok && i < 10000; i++) {
+        char key[32];
+        snprintf(key, sizeof(key), "key%d", i);
+        py_TValue value;
+        py_newstr(&value, text);
+        ok = py_dict_setitem_by_str(d, key, &value);
+        if(ok) {
+            ASSERT(py_dict_getitem_by_str(d, key) == 1);
+            ASSERT_STR_EQ(py_tostr(py_retval()), text);
+        }
+    }
+    if(!ok) {
+        ASSERT(py_matchexc(tp_MemoryError));
+        py_clearexc(NULL);
+    }
+    py_pop();
+
+    ph_vm_set_memory_limit(0);
+}
+
+TEST(memory_limit_garbage_is_collected) {
+    py_gc_collect();
+    ph_vm_set_memory_limit(ph_vm_memory_stats().used_size + 1024 * 1024);
+
+    // lots of short-lived garbage stays under the limit
+    bool ok = exec_keep_exc(
+        "for i in range(2000):\n"
+        "    s = 'y' * 10000\n"
+        "    l = [i] * 1000\n");
+    ASSERT(ok);
+
+    ph_vm_set_memory_limit(0);
+}
+
+TEST(memory_limit_per_vm) {
+    py_gc_collect();
+    ph_vm_set_memory_limit(ph_vm_memory_stats().used_size + 1024 * 1024);
+
+    py_switchvm(1);
+    ASSERT_EQ(ph_vm_memory_stats().limit, (size_t)0);
+    bool ok = ph_exec("x = [0] * 1000000", "<test>");
+    ASSERT(ok);
+    py_switchvm(0);
+
+    ph_vm_set_memory_limit(0);
+}
+
+/* ============================================================================
+ * ph_vm_create tests
+ * ============================================================================ */
+
+static const char* recurse_src =
+    "def depth(n):\n"
+    "    return 0 if n == 0 else depth(n - 1) + 1\n";
+
+TEST(vm_create_small_stack) {
+    ph_VMOptions opts = {.stack_size = 256};
+    int index = ph_vm_create(&opts);
+    ASSERT(index > 0);
+    ASSERT_EQ(py_currentvm(), 0);
+
+    py_switchvm(index);
+    ASSERT(ph_vm_memory_stats().stack_capacity < 16 * 1024);
+    ASSERT(ph_exec("x = sum([i * i for i in range(100)])", "<test>"));
+    ASSERT_EQ(py_toint(ph_getglobal("x")), 328350);
+
+    // running out of stack is an exception, not a crash
+    ASSERT(ph_exec(recurse_src, "<test>"));
+    ASSERT(!exec_keep_exc("depth(500)"));
+    ASSERT(py_matchexc(tp_RecursionError));
+    py_clearexc(NULL);
+    ASSERT(ph_exec("y = depth(10)", "<test>"));
+    ASSERT_EQ(py_toint(ph_getglobal("y")), 10);
+    py_switchvm(0);
+
+    ph_vm_destroy(index);
+}
+
+TEST(vm_create_small_stack_wide_expressions) {
+    ph_VMOptions opts = {.stack_size = 256};
+    int index = ph_vm_create(&opts);
+    ASSERT(index > 0);
+    py_switchvm(index);
+
+    // a literal wider than the stack
+    char src[4096] = "x = [";
+    for(int i = 0; i < 400; i++) strcat(src, "1,");
+    strcat(src, "]");
+    ASSERT(!exec_keep_exc(src));
+    ASSERT(py_matchexc(tp_RecursionError));
+    py_clearexc(NULL);
+
+    // unpacking into a call
+    ASSERT(ph_exec("import functools\n"
+                   "big = list(range(1000))\n"
+                   "def f(*args): return len(args)",
+                   "<test>"));
+    const char* sources[] = {
+        "f(*big)",
+        "f(*big, *big)",
+        "print(*big)",
+        "functools.partial(f, *big[:100])(*big[:200])",
+    };
+    for(int i = 0; i < 4; i++) {
+        ASSERT(!exec_keep_exc(sources[i]));
+        ASSERT(py_matchexc(tp_RecursionError));
+        py_clearexc(NULL);
+    }
+
+    // the VM is still usable
+    ASSERT(ph_exec("y = f(*big[:100])", "<test>"));
+    ASSERT_EQ(py_toint(ph_getglobal("y")), 100);
+    py_switchvm(0);
+    ph_vm_destroy(index);
+
+    ph_VMOptions tiny = {.stack_size = PK_VM_MIN_STACK_SIZE - 1};
+    ASSERT_EQ(ph_vm_create(&tiny), -1);
+}
+
+#ifdef PK_BUILD_MODULE_MSGPACK
+TEST(vm_create_small_stack_nested_msgpack) {
+    ph_VMOptions opts = {.stack_size = 256};
+    int index = ph_vm_create(&opts);
+    ASSERT(index > 0);
+    py_switchvm(index);
+
+    // {0: {0: ... {0: None}}}, nested within the msgpack depth limit but not the stack
+    unsigned char buf[401];
+    for(int i = 0; i < 200; i++) {
+        buf[i * 2] = 0x81;
+        buf[i * 2 + 1] = 0x00;
+    }
+    buf[400] = 0xc0;
+    ASSERT(!ph_msgpack_unpack_raise(buf, sizeof(buf)));
+    ASSERT(py_matchexc(tp_RecursionError));
+    py_clearexc(NULL);
+    ASSERT(ph_msgpack_unpack(buf + 300, sizeof(buf) - 300));
+    ASSERT(py_isdict(py_retval()));
+
+    py_switchvm(0);
+    ph_vm_destroy(index);
+}
+#endif
+
+TEST(vm_create_deep_recursion) {
+    ph_VMOptions opts = {.stack_size = 128 * 1024, .max_recursion_depth = 20000};
+    int index = ph_vm_create(&opts);
+    ASSERT(index > 0);
+
+    py_switchvm(index);
+    ASSERT(ph_exec(recurse_src, "<test>"));
+    ASSERT(ph_exec("y = depth(10000)", "<test>"));
+    ASSERT_EQ(py_toint(ph_getglobal("y")), 10000);
+
+    // reset keeps the options
+    py_resetvm();
+    ASSERT(ph_vm_memory_stats().stack_capacity >= 128 * 1024 * sizeof(py_TValue));
+    py_switchvm(0);
+
+    ph_vm_destroy(index);
+}
+
+TEST(vm_create_default_vm_has_default_stack) {
+    // the default recursion limit stops before the default stack runs out
+    ASSERT(ph_exec(recurse_src, "<test>"));
+    ASSERT(!exec_keep_exc("depth(5000)"));
+    ASSERT(py_matchexc(tp_RecursionError));
+    py_clearexc(NULL);
+    ASSERT(ph_vm_memory_stats().stack_capacity >= PK_VM_STACK_SIZE * sizeof(py_TValue));
+}
+
+TEST(vm_destroy_frees_slot) {
+    int index = ph_vm_create(NULL);
+    ASSERT(index > 0);
+    ph_vm_destroy(index);
+    ASSERT_EQ(ph_vm_create(NULL), index);
+    ph_vm_destroy(index);
+}
+
+/* ============================================================================
+ * ph_vm_stats tests
+ * ============================================================================ */
+
+TEST(vm_stats_default_pool_falls_back) {
+    ph_VMOptions opts = {0};
+    int index = ph_vm_create(&opts);
+    py_switchvm(index);
+    ph_VMStats before = ph_vm_stats();
+    ASSERT_EQ(before.frame_pool_size, 32);
+    ASSERT_EQ(before.recursion_depth, 0);
+
+    ASSERT(ph_exec(recurse_src, "<test>"));
+    ASSERT(ph_exec("depth(100)", "<test>"));
+    ph_VMStats after = ph_vm_stats();
+    ASSERT(after.peak_recursion_depth > 100);
+    ASSERT(after.frame_pool_misses > before.frame_pool_misses);
+    ASSERT(after.frame_pool_hits > before.frame_pool_hits);
+    ASSERT_EQ(after.frame_fallback_live, 0);
+    py_switchvm(0);
+
+    ph_vm_destroy(index);
+}
+
+TEST(vm_stats_sized_pool_has_no_misses) {
+    ph_VMOptions opts = {.frame_pool_size = 256};
+    int index = ph_vm_create(&opts);
+    py_switchvm(index);
+    ASSERT(ph_exec(recurse_src, "<test>"));
+    ASSERT(ph_exec("for _ in range(10): depth(100)", "<test>"));
+    ph_VMStats stats = ph_vm_stats();
+    ASSERT_EQ(stats.frame_pool_size, 256);
+    ASSERT_EQ(stats.frame_pool_misses, 0);
+    ASSERT(stats.frame_pool_hits >= 1000);
+
+    // reset keeps the pool size and restarts the counters
+    py_resetvm();
+    ph_VMStats reset = ph_vm_stats();
+    ASSERT_EQ(reset.frame_pool_size, 256);
+    ASSERT(reset.frame_pool_hits < stats.frame_pool_hits);
+    py_switchvm(0);
+
+    ph_vm_destroy(index);
+}
+
+/* ============================================================================
+ * Shared builtins tests
+ * ============================================================================ */
+
+static bool twice(int argc, py_Ref argv) {
+    (void)argc;
+    py_newint(py_retval(), py_toint(&argv[0]) * 2 + py_toint(&argv[1]));
+    return true;
+}
+
+TEST(shared_builtins_outlive_vm) {
+    int first = ph_vm_create(NULL);
+    py_switchvm(first);
+    ph_def("twice(x, extra=0)", twice);
+    ASSERT(ph_exec("import heapq", "<test>"));
+    py_switchvm(0);
+    ph_vm_destroy(first);
+
+    // sources compiled for the destroyed VM are reused by the next one
+    int second = ph_vm_create(NULL);
+    py_switchvm(second);
+    ph_def("twice(x, extra=0)", twice);
+    ASSERT(ph_exec(
+        "import heapq\n"
+        "h = []\n"
+        "for v in [5, 1, 4]: heapq.heappush(h, v)\n"
+        "out = str(heapq.heappop(h)) + '|' + str(twice(3)) + '|' + str(twice(3, extra=1))\n"
+        "joined = ','.join(sorted(['b', 'a']))\n",
+        "<test>"));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("out"), ""), "1|6|7");
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("joined"), ""), "a,b");
+
+    // string defaults of shared signatures are per-VM objects
+    ASSERT(ph_exec("import json\ns = json.dumps({'a': [1, 2]})", "<test>"));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("s"), ""), "{\"a\": [1, 2]}");
+    py_switchvm(0);
+    ph_vm_destroy(second);
+}
+
+TEST(dumpcode_serializes_module) {
+    int size = 0;
+    unsigned char* data = py_dumpcode("def f(x, *a, k='s'):\n    return (x, 1.5, 'abc', None)\n",
+                                      "m.py", &size);
+    ASSERT(data != NULL);
+    ASSERT(size > 16);
+    PK_FREE(data);
+
+    data = py_dumpcode("def f(:\n", "bad.py", &size);
+    ASSERT(data == NULL);
+    ASSERT(py_matchexc(tp_SyntaxError));
+    py_clearexc(NULL);
+}
+
+TEST(frozen_stdlib_runs) {
+    ASSERT(ph_exec(
+        "from dataclasses import dataclass\n"
+        "import datetime, operator\n"
+        "@dataclass\n"
+        "class P:\n"
+        "    x: int\n"
+        "    y: int = 2\n"
+        "d = datetime.date(2024, 3, 1)\n"
+        "out = repr(P(1)) + '|' + str(d < datetime.date(2024, 3, 2)) + '|' + str(operator.add(2, 3))\n",
+        "<test>"));
+    ASSERT_STR_EQ(ph_as_str(ph_getglobal("out"), ""), "P(x=1, y=2)|True|5");
+}
+
+TEST_SUITE_BEGIN("VM Management")
+    RUN_TEST(memory_stats_tracks_objects);
+    RUN_TEST(memory_stats_reclaimed);
+    RUN_TEST(memory_limit_bulk_allocation);
+    RUN_TEST(memory_limit_growth_loop);
+    RUN_TEST(memory_limit_single_native_call);
+    RUN_TEST(memory_limit_unrooted_c_values);
+    RUN_TEST(memory_limit_garbage_is_collected);
+    RUN_TEST(memory_limit_per_vm);
+    RUN_TEST(vm_create_small_stack);
+    RUN_TEST(vm_create_small_stack_wide_expressions);
+#ifdef PK_BUILD_MODULE_MSGPACK
+    RUN_TEST(vm_create_small_stack_nested_msgpack);
+#endif
+    RUN_TEST(vm_create_deep_recursion);
+    RUN_TEST(vm_create_default_vm_has_default_stack);
+    RUN_TEST(vm_destroy_frees_slot);
+    RUN_TEST(vm_stats_default_pool_falls_back);
+    RUN_TEST(vm_stats_sized_pool_has_no_misses);
+    RUN_TEST(shared_builtins_outlive_vm);
+    RUN_TEST(dumpcode_serializes_module);
+    RUN_TEST(frozen_stdlib_runs);
+TEST_SUITE_END()
@@ -0,0 +1,98 @@
+/*
+ * pk_freeze.c - Precompile pocketpy's builtin python sources
+ *
+ * Run at build time: compiles the builtins and the python stdlib modules
+ * with py_dumpcode() and writes them as a C table of byte arrays. Linking
+ * that table into a pocketpy built with PK_ENABLE_FROZEN_LIBS=1 lets the
+ * first VM load bytecode instead of compiling the sources.
+ *
+ * Usage: pk_freeze <output.c>
+ */
+
+#include "pocketpy.h"
+#include <stdio.h>
+
+extern const char kPythonLibs_builtins[];
+const char* load_kPythonLib(const char* name);
+
+/* pk_freeze runs before the real table exists */
+typedef struct {
+    const char* filename;
+    const unsigned char* data;
+    int size;
+} pk_FrozenLib;
+
+const pk_FrozenLib pk_frozen_libs[1] = {{NULL, NULL, 0}};
+const int pk_frozen_libs_count = 0;
+
+/* Python stdlib modules, as named by load_kPythonLib() */
+static const char* const stdlib_modules[] = {
+    "cmath", "collections", "dataclasses", "linalg",
+    "operator", "typing",
+};
+
+static bool write_lib(FILE* out, int index, const char* filename, const char* source) {
+    int size;
+    unsigned char* data = py_dumpcode(source, filename, &size);
+    if (data == NULL) {
+        py_printexc();
+        return false;
+    }
+    fprintf(out, "\n/* %s */\nstatic const unsigned char lib_%d[%d] = {", filename, index, size);
+    for (int i = 0; i < size; i++) {
+        fprintf(out, "%s%d,", i % 24 == 0 ? "\n    " : "", data[i]);
+    }
+    fprintf(out, "\n};\n");
+    PK_FREE(data);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <output.c>\n", argv[0]);
+        return 1;
+    }
+    FILE* out = fopen(argv[1], "w");
+    if (out == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    py_initialize();
+
+    int n_modules = (int)(sizeof(stdlib_modules) / sizeof(stdlib_modules[0]));
+    char filenames[sizeof(stdlib_modules) / sizeof(stdlib_modules[0])][64];
+    bool ok = true;
+
+    fprintf(out, "/* Generated by tools/pk_freeze.c, do not edit. */\n\n");
+    fprintf(out, "typedef struct {\n"
+                 "    const char* filename;\n"
+                 "    const unsigned char* data;\n"
+                 "    int size;\n"
+                 "} pk_FrozenLib;\n");
+    ok = ok && write_lib(out, 0, "<builtins>", kPythonLibs_builtins);
+    for (int i = 0; ok && i < n_modules; i++) {
+        const char* source = load_kPythonLib(stdlib_modules[i]);
+        if (source == NULL) {
+            fprintf(stderr, "pk_freeze: unknown module '%s'\n", stdlib_modules[i]);
+            ok = false;
+            break;
+        }
+        /* py_import names a builtin module's source after its path */
+        snprintf(filenames[i], sizeof(filenames[i]), "%s.py", stdlib_modules[i]);
+        ok = write_lib(out, i + 1, filenames[i], source);
+    }
+
+    if (ok) {
+        fprintf(out, "\nconst pk_FrozenLib pk_frozen_libs[] = {\n");
+        fprintf(out, "    {\"<builtins>\", lib_0, (int)sizeof(lib_0)},\n");
+        for (int i = 0; i < n_modules; i++) {
+            fprintf(out, "    {\"%s\", lib_%d, (int)sizeof(lib_%d)},\n", filenames[i], i + 1, i + 1);
+        }
+        fprintf(out, "};\n\nconst int pk_frozen_libs_count = %d;\n", n_modules + 1);
+    }
+
+    py_finalize();
+    if (fclose(out) != 0) ok = false;
+    if (!ok) remove(argv[1]);
+    return ok ? 0 : 1;
+}